@@ -0,0 +1,192 @@
+/* Copyright (C) 2019 Theodoric E. Stier - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * INFO: This file is intended to be viewed using a horizontal tab width of 4.
+ */
+
+// Contention benchmark for `concurrent_polymorphic_forward_list`.
+//
+// One writer inserts and erases elements of a list of 1000 elements while 0
+// to 8 readers traverse it repeatedly, yielding between traversals. The
+// writer's time and the readers' traversal count are compared with those of
+// a `polymorphic_forward_list` guarded by a `std::shared_mutex`.
+//
+// A second table times `remove_if` removing every element while a reader
+// holds a guard, during which no retired node may be reclaimed.
+
+/*
+	g++ -std=c++17 -O2 -pthread -fpermissive \
+		-I../polymorphic_forward_list \
+		concurrent_polymorphic_forward_list.cpp
+*/
+
+#include "polymorphic_forward_list.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	constexpr int list_size = 1000;
+	constexpr int writer_operations = 2000000;
+
+	struct Control
+	{
+		explicit Control(int id) :
+			id{ id }
+		{ }
+
+		virtual ~Control() = default;
+
+		int id;
+	};
+
+	struct Button : Control
+	{
+		using Control::Control;
+		float bounds[4] = {};
+	};
+
+	struct result
+	{
+		double writer_seconds;
+		long traversals;
+	};
+
+	auto seconds_since(std::chrono::steady_clock::time_point start) -> double
+	{
+		return std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+	}
+
+	// Each writer operation inserts an element after the 16th and erases the
+	// element after the 32nd.
+	auto run_concurrent(unsigned readers) -> result
+	{
+		concurrent_polymorphic_forward_list<Control> list;
+		for (int i = 0; i < list_size; i++) list.emplace_front<Button>(i);
+
+		std::atomic<bool> stop{ false };
+		std::atomic<long> traversals{ 0 };
+		std::vector<std::thread> threads;
+		for (unsigned r = 0; r < readers; r++)
+		{
+			threads.emplace_back([&]
+			{
+				long count = 0;
+				long sum = 0;
+				while (!stop.load(std::memory_order_relaxed))
+				{
+					for (Control const & control : list.read())
+					{
+						sum += control.id;
+					}
+					count++;
+					std::this_thread::yield();
+				}
+				traversals += count + (sum == 42);
+			});
+		}
+
+		auto const start = std::chrono::steady_clock::now();
+		for (int op = 0; op < writer_operations; op++)
+		{
+			auto it = list.begin();
+			for (int i = 0; i < 16; i++) ++it;
+			list.emplace_after<Button>(it, op);
+			for (int i = 0; i < 16; i++) ++it;
+			list.erase_after(it);
+		}
+		double const writer_seconds = seconds_since(start);
+		stop = true;
+		for (std::thread & thread : threads) thread.join();
+		return { writer_seconds, traversals.load() };
+	}
+
+	auto run_locked(unsigned readers) -> result
+	{
+		polymorphic_forward_list<Control> list;
+		std::shared_mutex mutex;
+		for (int i = 0; i < list_size; i++) list.emplace_front<Button>(i);
+
+		std::atomic<bool> stop{ false };
+		std::atomic<long> traversals{ 0 };
+		std::vector<std::thread> threads;
+		for (unsigned r = 0; r < readers; r++)
+		{
+			threads.emplace_back([&]
+			{
+				long count = 0;
+				long sum = 0;
+				while (!stop.load(std::memory_order_relaxed))
+				{
+					{
+						std::shared_lock<std::shared_mutex> lock{ mutex };
+						for (Control const & control : list)
+						{
+							sum += control.id;
+						}
+					}
+					count++;
+					// Without yielding, readers which outnumber the cores
+					// starve a writer waiting on a reader-preferring lock.
+					std::this_thread::yield();
+				}
+				traversals += count + (sum == 42);
+			});
+		}
+
+		auto const start = std::chrono::steady_clock::now();
+		for (int op = 0; op < writer_operations; op++)
+		{
+			std::lock_guard<std::shared_mutex> lock{ mutex };
+			auto it = list.begin();
+			for (int i = 0; i < 16; i++) ++it;
+			list.emplace_after<Button>(it, op);
+			for (int i = 0; i < 16; i++) ++it;
+			list.erase_after(it);
+		}
+		double const writer_seconds = seconds_since(start);
+		stop = true;
+		for (std::thread & thread : threads) thread.join();
+		return { writer_seconds, traversals.load() };
+	}
+
+	auto run_remove_if_pinned(int size) -> double
+	{
+		concurrent_polymorphic_forward_list<Control> list;
+		for (int i = 0; i < size; i++) list.emplace_front<Button>(i);
+		auto const guard = list.read();
+		auto const start = std::chrono::steady_clock::now();
+		list.remove_if([](Control const &) { return true; });
+		return seconds_since(start);
+	}
+}
+
+int main()
+{
+	std::printf("%8s %14s %14s %14s %14s\n",
+		"readers", "epoch_write_s", "epoch_reads", "mutex_write_s",
+		"mutex_reads");
+	for (unsigned readers : { 0u, 1u, 2u, 4u, 8u })
+	{
+		result const epoch = run_concurrent(readers);
+		result const locked = run_locked(readers);
+		std::printf("%8u %14.4f %14ld %14.4f %14ld\n",
+			readers,
+			epoch.writer_seconds, epoch.traversals,
+			locked.writer_seconds, locked.traversals);
+	}
+
+	std::printf("\n%8s %14s\n", "size", "remove_if_s");
+	for (int size : { 20000, 40000, 80000, 160000 })
+	{
+		std::printf("%8d %14.4f\n", size, run_remove_if_pinned(size));
+	}
+}
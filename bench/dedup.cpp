@@ -0,0 +1,159 @@
+/* Copyright (C) 2019 Theodoric E. Stier - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * INFO: This file is intended to be viewed using a horizontal tab width of 4.
+ */
+
+// Duplicate removal from lists of 10^6 elements at varying duplicate ratios.
+//
+// `dedup` is compared with `remove_if` filtering through a
+// `std::unordered_set` of the elements seen so far, which destroys each
+// duplicate as it is found. `unique` is timed on the same elements with
+// duplicates made adjacent.
+
+/*
+	g++ -std=c++17 -O2 -fpermissive \
+		-I../polymorphic_forward_list \
+		dedup.cpp
+*/
+
+#include "polymorphic_forward_list.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+	constexpr std::size_t element_count = 1000000;
+
+	struct Glyph
+	{
+		explicit Glyph(long code) :
+			code{ code }
+		{ }
+
+		virtual ~Glyph() = default;
+
+		auto operator==(Glyph const & other) const -> bool
+		{
+			return code == other.code;
+		}
+
+		long code;
+	};
+
+	struct Outline : Glyph
+	{
+		using Glyph::Glyph;
+		float points[8] = {};
+	};
+
+	struct glyph_hash
+	{
+		auto operator()(Glyph const & glyph) const -> std::size_t
+		{
+			return std::hash<long>{}(glyph.code);
+		}
+	};
+
+	struct glyph_pointer_hash
+	{
+		auto operator()(Glyph const * glyph) const -> std::size_t
+		{
+			return glyph_hash{}(*glyph);
+		}
+	};
+
+	struct glyph_pointer_equal
+	{
+		auto operator()(Glyph const * a, Glyph const * b) const -> bool
+		{
+			return *a == *b;
+		}
+	};
+
+	using list = polymorphic_forward_list<Glyph>;
+
+	// Codes of which `ratio` are duplicates of earlier codes.
+	auto make_codes(double ratio, bool adjacent) -> std::vector<long>
+	{
+		std::mt19937_64 random{ 42 };
+		auto const distinct = static_cast<std::size_t>(
+			std::llround(element_count * (1 - ratio)));
+		std::vector<long> codes;
+		codes.reserve(element_count);
+		for (std::size_t i = 0; i < element_count; i++)
+		{
+			codes.push_back(static_cast<long>(
+				i < distinct ? i : random() % (distinct ? distinct : 1)));
+		}
+		if (adjacent) std::sort(codes.begin(), codes.end());
+		else std::shuffle(codes.begin(), codes.end(), random);
+		return codes;
+	}
+
+	void fill(list & l, std::vector<long> const & codes)
+	{
+		for (auto it = codes.rbegin(); it != codes.rend(); ++it)
+		{
+			if (*it % 4) l.emplace_front<Glyph>(*it);
+			else l.emplace_front<Outline>(*it);
+		}
+	}
+
+	template<class Function>
+	auto time(Function f) -> double
+	{
+		auto const start = std::chrono::steady_clock::now();
+		f();
+		return std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+	}
+}
+
+int main()
+{
+	std::printf("%9s %12s %14s %12s %12s\n",
+		"dup_ratio", "dedup_s", "set_filter_s", "unique_s", "removed");
+	for (double ratio : { 0.0, 0.1, 0.5, 0.9, 0.99 })
+	{
+		std::vector<long> const shuffled = make_codes(ratio, false);
+		std::vector<long> const sorted = make_codes(ratio, true);
+
+		list a;
+		fill(a, shuffled);
+		std::size_t removed = 0;
+		double const dedup_seconds = time([&]
+		{
+			removed = a.dedup(glyph_hash{});
+		});
+
+		list b;
+		fill(b, shuffled);
+		double const filter_seconds = time([&]
+		{
+			std::unordered_set<
+				Glyph const *,
+				glyph_pointer_hash,
+				glyph_pointer_equal> seen;
+			b.remove_if([&](Glyph const & glyph)
+			{
+				return !seen.insert(&glyph).second;
+			});
+		});
+
+		list c;
+		fill(c, sorted);
+		double const unique_seconds = time([&] { c.unique(); });
+
+		std::printf("%9.2f %12.4f %14.4f %12.4f %12zu\n",
+			ratio, dedup_seconds, filter_seconds, unique_seconds, removed);
+	}
+}
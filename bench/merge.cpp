@@ -0,0 +1,155 @@
+/* Copyright (C) 2019 Theodoric E. Stier - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * INFO: This file is intended to be viewed using a horizontal tab width of 4.
+ */
+
+// Merging k sorted lists of 10^6 elements in total, for k from 2 to 256 and
+// for runs of 1 to 1024 consecutive merged elements coming from the same
+// list.
+//
+// Pairwise merging folds each list into the first in turn, either splicing
+// one element at a time as `merge` did before it spliced runs, or with
+// `merge`. Both are compared with a single `merge_all`.
+
+/*
+	g++ -std=c++17 -O2 -fpermissive \
+		-I../polymorphic_forward_list \
+		merge.cpp
+*/
+
+#include "polymorphic_forward_list.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+	constexpr long element_count = 1000000;
+
+	struct Event
+	{
+		explicit Event(long time) :
+			time{ time }
+		{ }
+
+		virtual ~Event() = default;
+
+		auto operator<(Event const & other) const -> bool
+		{
+			return time < other.time;
+		}
+
+		long time;
+	};
+
+	struct Input : Event
+	{
+		using Event::Event;
+		int keys[4] = {};
+	};
+
+	using list = polymorphic_forward_list<Event>;
+
+	// Deals runs of `run` consecutive times to the lists in turn, so that
+	// each list is sorted and the merged order alternates between them.
+	auto make_lists(std::size_t k, long run) -> std::vector<list>
+	{
+		std::vector<list> lists(k);
+		std::vector<list::iterator> ends;
+		for (list & l : lists) ends.push_back(l.before_begin());
+		for (long time = 0; time < element_count; time++)
+		{
+			std::size_t const i = static_cast<std::size_t>(time / run) % k;
+			ends[i] = time % 2 ?
+				lists[i].emplace_after<Input>(ends[i], time) :
+				lists[i].emplace_after<Event>(ends[i], time);
+		}
+		return lists;
+	}
+
+	// The merge without run splicing: one relink per element of `other`.
+	void merge_elementwise(list & l, list & other)
+	{
+		auto pos = l.before_begin();
+		while (!other.empty())
+		{
+			auto next = pos;
+			++next;
+			if (next == l.end() || other.front() < *next)
+			{
+				l.splice_after(pos, other.before_begin());
+				++pos;
+			}
+			else
+			{
+				pos = next;
+			}
+		}
+	}
+
+	auto is_sorted(list const & l) -> bool
+	{
+		long count = 0;
+		long previous = -1;
+		for (Event const & event : l)
+		{
+			if (event.time != previous + 1) return false;
+			previous = event.time;
+			count++;
+		}
+		return count == element_count;
+	}
+
+	// The best of three, each on freshly built lists.
+	template<class Function>
+	auto time(std::size_t k, long run, Function f) -> double
+	{
+		double best = 0;
+		for (int repeat = 0; repeat < 3; repeat++)
+		{
+			std::vector<list> lists = make_lists(k, run);
+			auto const start = std::chrono::steady_clock::now();
+			f(lists);
+			double const seconds = std::chrono::duration<double>(
+				std::chrono::steady_clock::now() - start).count();
+			if (!is_sorted(lists.front())) std::puts("merge failed");
+			if (!repeat || seconds < best) best = seconds;
+		}
+		return best;
+	}
+}
+
+int main()
+{
+	std::printf("%6s %6s %14s %12s %12s\n",
+		"k", "run", "elementwise_s", "merge_s", "merge_all_s");
+	for (std::size_t k : { 2, 8, 64, 256 })
+	{
+		for (long run : { 1, 32, 1024 })
+		{
+			double const elementwise = time(k, run, [](std::vector<list> & l)
+			{
+				for (std::size_t i = 1; i < l.size(); i++)
+				{
+					merge_elementwise(l.front(), l[i]);
+				}
+			});
+			double const pairwise = time(k, run, [](std::vector<list> & l)
+			{
+				for (std::size_t i = 1; i < l.size(); i++)
+				{
+					l.front().merge(l[i]);
+				}
+			});
+			double const k_way = time(k, run, [](std::vector<list> & l)
+			{
+				l.front().merge_all(l);
+			});
+			std::printf("%6zu %6ld %14.4f %12.4f %12.4f\n",
+				k, run, elementwise, pairwise, k_way);
+		}
+	}
+}
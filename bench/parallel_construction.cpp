@@ -0,0 +1,102 @@
+/* Copyright (C) 2019 Theodoric E. Stier - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * INFO: This file is intended to be viewed using a horizontal tab width of 4.
+ */
+
+// Strong scaling of parallel construction from a range of 10^7 elements, or
+// of the count given as the first argument, from 1 to 32 threads. Times are
+// compared with the sequential range constructor, with the default node
+// allocator and with `thread_local_node_cache`. `-ltbb` is needed only
+// where libstdc++ finds TBB.
+
+/*
+	g++ -std=c++17 -O2 -pthread -fpermissive \
+		-I../polymorphic_forward_list \
+		parallel_construction.cpp -ltbb
+*/
+
+#define PFL_ENABLE_PARALLEL
+#include "polymorphic_forward_list.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+	struct Particle
+	{
+		explicit Particle(float seed) :
+			position{ seed, seed, seed }
+		{ }
+
+		virtual ~Particle() = default;
+
+		float position[3];
+		float velocity[3] = {};
+	};
+
+	template<class Function>
+	auto time(Function f) -> double
+	{
+		auto const start = std::chrono::steady_clock::now();
+		f();
+		return std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+	}
+
+	// Times construction alone; destruction is excluded. An untimed build
+	// first warms the heap, so that the first timed build does not pay for
+	// faulting in fresh pages.
+	template<class Node_Allocator>
+	void run(char const * name, std::vector<Particle> const & source)
+	{
+		using list = polymorphic_forward_list<Particle, Node_Allocator>;
+
+		list(source.begin(), source.end()).clear();
+		list sequential_list;
+		double const sequential = time([&]
+		{
+			sequential_list = list(source.begin(), source.end());
+		});
+		sequential_list.clear();
+		std::printf("%-10s %8s %12.4f %8.2f\n",
+			name, "seq", sequential, 1.0);
+
+		for (std::size_t threads = 1; threads <= 32; threads *= 2)
+		{
+			list parallel_list;
+			double const parallel = time([&]
+			{
+				parallel_list.assign(
+					std::execution::par,
+					source.begin(),
+					source.end(),
+					threads);
+			});
+			std::printf("%-10s %8zu %12.4f %8.2f\n",
+				name, threads, parallel, sequential / parallel);
+		}
+	}
+}
+
+int main(int argc, char ** argv)
+{
+	std::size_t const count = argc > 1 ?
+		std::strtoull(argv[1], nullptr, 10) :
+		10000000;
+	std::vector<Particle> source;
+	source.reserve(count);
+	for (std::size_t i = 0; i < count; i++)
+	{
+		source.emplace_back(static_cast<float>(i));
+	}
+
+	std::printf("%-10s %8s %12s %8s\n",
+		"allocator", "threads", "seconds", "speedup");
+	run<default_node_allocator>("default", source);
+	run<thread_local_node_cache<>>("cache", source);
+}
@@ -0,0 +1,139 @@
+/* Copyright (C) 2019 Theodoric E. Stier - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * INFO: This file is intended to be viewed using a horizontal tab width of 4.
+ */
+
+// Thread scaling of node churn with `default_node_allocator` and with
+// `thread_local_node_cache`, from 1 to 64 threads.
+//
+// In the local pattern, each thread builds and destroys its own lists. In the
+// handoff pattern, each list is destroyed by the next thread, so that every
+// node is freed remotely.
+
+/*
+	g++ -std=c++17 -O2 -pthread -fpermissive \
+		-I../polymorphic_forward_list \
+		thread_local_node_cache.cpp
+*/
+
+#include "polymorphic_forward_list.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	constexpr std::size_t list_size = 1000;
+	constexpr std::size_t total_rounds = 1 << 12;
+
+	struct Shape
+	{
+		virtual ~Shape() = default;
+		int id = 0;
+	};
+
+	struct Circle : Shape
+	{
+		double radius = 1;
+	};
+
+	struct Polygon : Shape
+	{
+		double points[6] = {};
+	};
+
+	// A reusable spin barrier, since std::barrier requires C++20.
+	class barrier
+	{
+	public:
+		explicit barrier(std::size_t count) :
+			count{ count }
+		{ }
+
+		void arrive_and_wait() noexcept
+		{
+			std::size_t const phase = generation.load();
+			if (waiting.fetch_add(1) + 1 == count)
+			{
+				waiting.store(0);
+				generation.fetch_add(1);
+				return;
+			}
+			while (generation.load() == phase) std::this_thread::yield();
+		}
+
+	private:
+		std::size_t const count;
+		std::atomic<std::size_t> waiting{ 0 };
+		std::atomic<std::size_t> generation{ 0 };
+	};
+
+	template<class List>
+	void fill(List & list)
+	{
+		for (std::size_t i = 0; i < list_size; i++)
+		{
+			if (i % 3) list.template emplace_front<Circle>();
+			else list.template emplace_front<Polygon>();
+		}
+	}
+
+	// Returns the seconds taken for `threads` threads to share `total_rounds`
+	// rounds of building and destroying a list.
+	template<class Node_Allocator>
+	auto run(std::size_t threads, bool handoff) -> double
+	{
+		using list = polymorphic_forward_list<Shape, Node_Allocator>;
+		std::size_t const rounds = total_rounds / threads;
+		std::vector<list> slots(threads);
+		barrier sync{ threads };
+		auto const start = std::chrono::steady_clock::now();
+		std::vector<std::thread> workers;
+		for (std::size_t t = 0; t < threads; t++)
+		{
+			workers.emplace_back([&, t]
+			{
+				for (std::size_t r = 0; r < rounds; r++)
+				{
+					if (!handoff)
+					{
+						list local;
+						fill(local);
+						continue;
+					}
+					fill(slots[t]);
+					sync.arrive_and_wait();
+					slots[(t + 1) % threads].clear();
+					sync.arrive_and_wait();
+				}
+			});
+		}
+		for (std::thread & worker : workers) worker.join();
+		return std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+	}
+}
+
+int main()
+{
+	std::printf("%8s %8s %12s %12s %8s\n",
+		"pattern", "threads", "default_s", "cache_s", "speedup");
+	for (bool const handoff : { false, true })
+	{
+		for (std::size_t threads = 1; threads <= 64; threads *= 2)
+		{
+			double const global = run<default_node_allocator>(
+				threads, handoff);
+			double const cached = run<thread_local_node_cache<>>(
+				threads, handoff);
+			std::printf("%8s %8zu %12.4f %12.4f %8.2f\n",
+				handoff ? "handoff" : "local",
+				threads, global, cached, global / cached);
+		}
+	}
+}
@@ -8,7 +8,35 @@
 #ifndef POLYMORPHIC_FORWARD_LIST_HPP
 #define POLYMORPHIC_FORWARD_LIST_HPP
 
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <iterator>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if __has_include(<version>)
+#include <version>
+#endif
+#ifdef __cpp_lib_span
+#include <span>
+#endif
+
+// Parallel construction from a range is enabled by defining
+// PFL_ENABLE_PARALLEL before including this header. It is opt-in because
+// libstdc++'s <execution> requires linking with TBB where TBB is installed.
+#ifdef PFL_ENABLE_PARALLEL
+#include <exception>
+#include <execution>
+#include <thread>
+#endif
 
 #if __has_cpp_attribute(nodiscard)
 #define PFL_NODISCARD [[nodiscard]]
@@ -16,7 +44,323 @@
 #define PFL_NODISCARD
 #endif
 
-template<class Elem_Base>
+#ifdef __cpp_constexpr_dynamic_alloc
+#define PFL_CONSTEXPR constexpr
+#else
+#define PFL_CONSTEXPR
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PFL_PREFETCH(p) __builtin_prefetch(p)
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <xmmintrin.h>
+#define PFL_PREFETCH(p) \
+	_mm_prefetch(reinterpret_cast<char const *>(p), _MM_HINT_T0)
+#else
+#define PFL_PREFETCH(p) static_cast<void>(p)
+#endif
+
+//------------------------------------------------------------------------------
+//
+//
+// Node Allocators
+//
+//
+//------------------------------------------------------------------------------
+
+// A node allocator is a type having the static member functions
+// `allocate(size)` and `deallocate(p, size)`. Nodes of over-aligned types are
+// always allocated by the global allocation functions.
+
+struct default_node_allocator
+{
+	static auto allocate(size_t size) -> void *
+	{
+		return ::operator new(size);
+	}
+
+	static void deallocate(void * p, size_t size) noexcept
+	{
+		::operator delete(p, size);
+	}
+};
+
+// Caches freed nodes per thread, bucketed by size. Each bucket holds at most
+// `Bucket_Capacity` nodes; nodes larger than `Max_Node_Size` bypass the cache.
+// A node freed by a thread other than the one which allocated it is returned
+// to the owning cache through a lock-free remote-free queue, which the owner
+// drains when a bucket runs dry. A queue which grows past what the cache can
+// hold, or whose owning thread has exited, is freed by the thread pushing to
+// it. A cache is recycled by the next thread to start when its thread exits,
+// so nodes may outlive their allocating thread.
+template<size_t Bucket_Capacity = 512, size_t Max_Node_Size = 256>
+class thread_local_node_cache
+{
+public:
+	static auto allocate(size_t size) -> void *
+	{
+		if (size > Max_Node_Size) return ::operator new(size);
+		size_t const bucket = (size - 1) / granularity;
+		cache * const local = local_cache();
+		if (local)
+		{
+			if (!local->buckets[bucket]) local->collect();
+			if (free_block * const block = local->buckets[bucket])
+			{
+				local->buckets[bucket] = block->next;
+				local->counts[bucket]--;
+				header_of(block)->owner = local;
+				return block;
+			}
+		}
+		header * const h = static_cast<header *>(
+			::operator new(block_size(bucket)));
+		h->owner = local;
+		return h + 1;
+	}
+
+	static void deallocate(void * p, size_t size) noexcept
+	{
+		if (size > Max_Node_Size)
+		{
+			::operator delete(p, size);
+			return;
+		}
+		size_t const bucket = (size - 1) / granularity;
+		cache * const owner = header_of(p)->owner;
+		if (!owner)
+		{
+			::operator delete(header_of(p), block_size(bucket));
+		}
+		// Only compares with the current cache, since a thread which has
+		// never allocated must not acquire a cache just to free a node.
+		else if (owner == local_state().current)
+		{
+			owner->push(static_cast<free_block *>(p), bucket);
+		}
+		else
+		{
+			owner->push_remote(static_cast<free_block *>(p), bucket);
+		}
+	}
+
+private:
+	static constexpr size_t granularity = alignof(std::max_align_t);
+	static constexpr size_t bucket_count =
+		(Max_Node_Size + granularity - 1) / granularity;
+
+	struct cache;
+
+	struct alignas(std::max_align_t) header
+	{
+		cache * owner;
+	};
+
+	struct free_block
+	{
+		free_block * next;
+		size_t bucket;
+	};
+
+	struct cache
+	{
+		void push(free_block * block, size_t bucket) noexcept
+		{
+			if (counts[bucket] == Bucket_Capacity)
+			{
+				::operator delete(header_of(block), block_size(bucket));
+				return;
+			}
+			block->next = buckets[bucket];
+			buckets[bucket] = block;
+			counts[bucket]++;
+		}
+
+		// The push and the read of `idle` are sequentially consistent, and
+		// pair with the store to `idle` and the drain when a thread exits, so
+		// that either the pusher sees the owner idle or the owner sees the
+		// pushed node.
+		void push_remote(free_block * block, size_t bucket) noexcept
+		{
+			block->bucket = bucket;
+			size_t const queued =
+				remote_count.fetch_add(1, std::memory_order_relaxed) + 1;
+			block->next = remote.load(std::memory_order_relaxed);
+			while (!remote.compare_exchange_weak(
+				block->next,
+				block,
+				std::memory_order_seq_cst,
+				std::memory_order_relaxed));
+			if (idle.load(std::memory_order_seq_cst) ||
+				queued > Bucket_Capacity * bucket_count)
+			{
+				release_remote();
+			}
+		}
+
+		void collect() noexcept
+		{
+			free_block * block = remote.exchange(
+				nullptr,
+				std::memory_order_acquire);
+			while (block)
+			{
+				free_block * const next = block->next;
+				remote_count.fetch_sub(1, std::memory_order_relaxed);
+				push(block, block->bucket);
+				block = next;
+			}
+		}
+
+		// Frees the queued nodes to the global allocator. May be called by
+		// any thread.
+		void release_remote() noexcept
+		{
+			free_block * block = remote.exchange(
+				nullptr,
+				std::memory_order_acquire);
+			while (block)
+			{
+				free_block * const next = block->next;
+				remote_count.fetch_sub(1, std::memory_order_relaxed);
+				::operator delete(header_of(block), block_size(block->bucket));
+				block = next;
+			}
+		}
+
+		void release() noexcept
+		{
+			collect();
+			for (size_t bucket = 0; bucket < bucket_count; bucket++)
+			{
+				while (free_block * const block = buckets[bucket])
+				{
+					buckets[bucket] = block->next;
+					::operator delete(header_of(block), block_size(bucket));
+				}
+				counts[bucket] = 0;
+			}
+		}
+
+		free_block * buckets[bucket_count] = {};
+		size_t counts[bucket_count] = {};
+		std::atomic<free_block *> remote{ nullptr };
+		std::atomic<size_t> remote_count{ 0 };
+		std::atomic<bool> idle{ false };
+		cache * next_idle = nullptr;
+	};
+
+	struct registry
+	{
+		std::mutex mutex;
+		cache * idle = nullptr;
+	};
+
+	struct thread_state
+	{
+		cache * current;
+		bool finished;
+	};
+
+	struct thread_handle
+	{
+		~thread_handle()
+		{
+			thread_state & state = local_state();
+			cache * const released = state.current;
+			state.current = nullptr;
+			state.finished = true;
+			released->idle.store(true, std::memory_order_seq_cst);
+			released->release();
+			registry & r = global_registry();
+			std::lock_guard<std::mutex> lock{ r.mutex };
+			released->next_idle = r.idle;
+			r.idle = released;
+		}
+	};
+
+	static auto header_of(void * p) noexcept -> header *
+	{
+		return static_cast<header *>(p) - 1;
+	}
+
+	static constexpr auto block_size(size_t bucket) noexcept -> size_t
+	{
+		return sizeof(header) + (bucket + 1) * granularity;
+	}
+
+	static auto global_registry() noexcept -> registry &
+	{
+		// Leaked, so that threads finishing during static destruction may
+		// still return their caches.
+		static registry & r = *new registry;
+		return r;
+	}
+
+	static auto local_state() noexcept -> thread_state &
+	{
+		thread_local thread_state state{ nullptr, false };
+		return state;
+	}
+
+	// Returns null once the calling thread has begun to exit.
+	static auto local_cache() -> cache *
+	{
+		thread_state & state = local_state();
+		if (state.current || state.finished) return state.current;
+		registry & r = global_registry();
+		{
+			std::lock_guard<std::mutex> lock{ r.mutex };
+			state.current = r.idle;
+			if (r.idle) r.idle = r.idle->next_idle;
+		}
+		if (state.current)
+		{
+			state.current->idle.store(false, std::memory_order_relaxed);
+		}
+		else
+		{
+			state.current = new cache;
+		}
+		thread_local thread_handle handle;
+		return state.current;
+	}
+};
+
+// The base of every node type, through which its allocation is routed to a
+// node allocator. Over-aligned nodes use the global allocation functions.
+template<class Node_Allocator>
+struct polymorphic_node_allocation
+{
+	static auto operator new(size_t size) -> void *
+	{
+		return Node_Allocator::allocate(size);
+	}
+	static auto operator new(size_t size, std::align_val_t align) -> void *
+	{
+		return ::operator new(size, align);
+	}
+
+	static void operator delete(void * p, size_t size) noexcept
+	{
+		Node_Allocator::deallocate(p, size);
+	}
+	static void operator delete(
+		void * p,
+		size_t size,
+		std::align_val_t align) noexcept
+	{
+		::operator delete(p, size, align);
+	}
+};
+
+// Nodes of lists using the default allocator are allocated by plain
+// new-expressions, which may be evaluated in constant expressions.
+template<>
+struct polymorphic_node_allocation<default_node_allocator>
+{ };
+
+template<class Elem_Base, class Node_Allocator = default_node_allocator>
 class polymorphic_forward_list
 {
 public:
@@ -49,23 +393,27 @@ private:
 		auto operator=(link &&)->link & = delete;
 		~link() = default;
 
-		link(basic_node * next) noexcept :
+		PFL_CONSTEXPR link(basic_node * next) noexcept :
 			next{ next }
 		{ }
 
 		basic_node * next;
 	};
 
-	struct basic_node : link
+	struct basic_node : link, polymorphic_node_allocation<Node_Allocator>
 	{
-		basic_node(link & after, reference ref) noexcept :
-			link{ after.next },
+		PFL_CONSTEXPR basic_node(basic_node * next, reference ref) noexcept :
+			link{ next },
 			ref{ ref }
-		{
-			after.next = this;
-		}
+		{ }
 
-		virtual ~basic_node() noexcept = default;
+		PFL_CONSTEXPR virtual ~basic_node() noexcept = default;
+
+		// Identifies the node type without RTTI, by the address of a static
+		// member of the node type. The member is mutable, since a linker
+		// folding identical constants (MSVC /OPT:ICF) could give the tags of
+		// two node types one address.
+		virtual auto type_tag() const noexcept -> void const * = 0;
 
 		reference ref;
 	};
@@ -74,7 +422,7 @@ private:
 	struct basic_owner
 	{
 		template<class ... Args>
-		basic_owner(Args && ... args)
+		PFL_CONSTEXPR basic_owner(Args && ... args)
 			noexcept(noexcept(Elem_Derived{ std::forward<Args>(args) ... })) :
 			elem{ std::forward<Args>(args) ... }
 		{ }
@@ -86,11 +434,23 @@ private:
 	struct node : basic_owner<Elem_Derived>, basic_node
 	{
 		template<class ... Args>
-		node(link & after, Args && ... args)
+		PFL_CONSTEXPR node(basic_node * next, Args && ... args)
 			noexcept(noexcept(Elem_Derived{ std::forward<Args>(args) ... })) :
 			basic_owner<Elem_Derived>{ std::forward<Args>(args) ... },
-			basic_node{ after, basic_owner<Elem_Derived>::elem }
+			basic_node{ next, basic_owner<Elem_Derived>::elem }
+		{ }
+
+		// User-provided, since GCC will not evaluate an implicit virtual
+		// destructor in a constant expression.
+		PFL_CONSTEXPR ~node() noexcept
 		{ }
+
+		auto type_tag() const noexcept -> void const * override
+		{
+			return &tag;
+		}
+
+		static inline char tag = 0;
 	};
 
 public:
@@ -121,32 +481,32 @@ public:
 		iterator(iterator const &) noexcept = default;
 		auto operator=(iterator const &) noexcept->iterator & = default;
 
-		auto operator*() const noexcept -> reference
+		PFL_CONSTEXPR auto operator*() const noexcept -> reference
 		{
 			return static_cast<basic_node &>(*p).ref;
 		}
-		auto operator->() const noexcept -> pointer
+		PFL_CONSTEXPR auto operator->() const noexcept -> pointer
 		{
 			return &static_cast<basic_node &>(*p).ref;
 		}
 
-		auto operator++() noexcept -> iterator &
+		PFL_CONSTEXPR auto operator++() noexcept -> iterator &
 		{
 			p = p->next;
 			return *this;
 		}
-		auto operator++(int) noexcept -> iterator
+		PFL_CONSTEXPR auto operator++(int) noexcept -> iterator
 		{
 			iterator copy = *this;
 			p = p->next;
 			return copy;
 		}
 
-		auto operator!=(iterator const & other) noexcept -> bool
+		PFL_CONSTEXPR auto operator!=(iterator const & other) noexcept -> bool
 		{
 			return p != other.p;
 		}
-		auto operator==(iterator const & other) noexcept -> bool
+		PFL_CONSTEXPR auto operator==(iterator const & other) noexcept -> bool
 		{
 			return p == other.p;
 		}
@@ -154,10 +514,10 @@ public:
 	private:
 		link * p = nullptr;
 
-		iterator(const_iterator const & other) :
+		PFL_CONSTEXPR iterator(const_iterator const & other) :
 			p{ other.p }
 		{ }
-		iterator(link * p) noexcept :
+		PFL_CONSTEXPR iterator(link * p) noexcept :
 			p{ p }
 		{ }
 	};
@@ -173,7 +533,7 @@ public:
 		using reference = const_reference;
 		using iterator_category = std::forward_iterator_tag;
 
-		const_iterator(iterator const & other) :
+		PFL_CONSTEXPR const_iterator(iterator const & other) :
 			p{ other.p }
 		{ }
 
@@ -182,32 +542,34 @@ public:
 		auto operator=(const_iterator const &) noexcept
 			->const_iterator & = default;
 
-		auto operator*() const noexcept -> reference
+		PFL_CONSTEXPR auto operator*() const noexcept -> reference
 		{
 			return static_cast<basic_node const &>(*p).ref;
 		}
-		auto operator->() const noexcept -> pointer
+		PFL_CONSTEXPR auto operator->() const noexcept -> pointer
 		{
 			return &static_cast<basic_node const &>(*p).ref;
 		}
 
-		auto operator++() noexcept -> const_iterator &
+		PFL_CONSTEXPR auto operator++() noexcept -> const_iterator &
 		{
 			p = p->next;
 			return *this;
 		}
-		auto operator++(int) noexcept -> const_iterator
+		PFL_CONSTEXPR auto operator++(int) noexcept -> const_iterator
 		{
 			const_iterator copy = *this;
 			p = p->next;
 			return copy;
 		}
 
-		auto operator!=(const_iterator const & other) noexcept -> bool
+		PFL_CONSTEXPR auto operator!=(const_iterator const & other) noexcept
+			-> bool
 		{
 			return p != other.p;
 		}
-		auto operator==(const_iterator const & other) noexcept -> bool
+		PFL_CONSTEXPR auto operator==(const_iterator const & other) noexcept
+			-> bool
 		{
 			return p == other.p;
 		}
@@ -215,11 +577,107 @@ public:
 	private:
 		link * p = nullptr;
 
-		const_iterator(link * p) noexcept :
+		PFL_CONSTEXPR const_iterator(link * p) noexcept :
 			p{ p }
 		{ }
 	};
 
+#ifdef __cpp_constexpr_dynamic_alloc
+
+	//--------------------------------------------------------------------------
+	//
+	//
+	// Static Image
+	//
+	//
+	//--------------------------------------------------------------------------
+
+	// A fixed chain of elements of the given types which is linked in order
+	// without allocation. An image declared `constexpr` or `constinit` is built
+	// entirely during constant evaluation, so it costs nothing at startup.
+	// Under GCC, element types with virtual destructors must declare them
+	// `constexpr`, as `node` does.
+	template<class ... Elem_Deriveds>
+	class static_image
+	{
+	public:
+		constexpr static_image(Elem_Deriveds ... elems) :
+			root{ nullptr },
+			nodes{ std::move(elems) ... }
+		{
+			root.next = nodes.head();
+		}
+
+		static_image(static_image const &) = delete;
+		auto operator=(static_image const &)->static_image & = delete;
+
+		PFL_NODISCARD constexpr auto front() noexcept -> reference
+		{
+			return root.next->ref;
+		}
+		PFL_NODISCARD constexpr auto front() const noexcept -> const_reference
+		{
+			return root.next->ref;
+		}
+
+		PFL_NODISCARD constexpr auto begin() noexcept -> iterator
+		{
+			return root.next;
+		}
+		PFL_NODISCARD constexpr auto end() noexcept -> iterator
+		{
+			return nullptr;
+		}
+
+		PFL_NODISCARD constexpr auto begin() const noexcept -> const_iterator
+		{
+			return root.next;
+		}
+		PFL_NODISCARD constexpr auto end() const noexcept -> const_iterator
+		{
+			return nullptr;
+		}
+
+		PFL_NODISCARD constexpr auto empty() const noexcept -> bool
+		{
+			return !root.next;
+		}
+
+	private:
+		template<class ... Elems>
+		struct chain
+		{
+			constexpr auto head() noexcept -> basic_node *
+			{
+				return nullptr;
+			}
+		};
+
+		template<class Elem, class ... Elems>
+		struct chain<Elem, Elems ...>
+		{
+			constexpr chain(Elem && elem, Elems && ... elems) :
+				first{ nullptr, std::move(elem) },
+				rest{ std::move(elems) ... }
+			{
+				first.next = rest.head();
+			}
+
+			constexpr auto head() noexcept -> basic_node *
+			{
+				return &first;
+			}
+
+			node<Elem> first;
+			chain<Elems ...> rest;
+		};
+
+		link root;
+		chain<Elem_Deriveds ...> nodes;
+	};
+
+#endif
+
 	//--------------------------------------------------------------------------
 	//
 	//
@@ -248,28 +706,32 @@ public:
 	auto operator=(polymorphic_forward_list const & other)
 		->polymorphic_forward_list & = delete;
 
-	polymorphic_forward_list() noexcept :
+	PFL_CONSTEXPR polymorphic_forward_list() noexcept :
 		root{ nullptr }
 	{}
 
-	polymorphic_forward_list(polymorphic_forward_list && other) noexcept :
+	PFL_CONSTEXPR polymorphic_forward_list(polymorphic_forward_list && other)
+		noexcept :
 		root{ other.root.next }
 	{
 		other.root.next = nullptr;
 	}
 
-	auto operator=(polymorphic_forward_list && other) noexcept
+	PFL_CONSTEXPR auto operator=(polymorphic_forward_list && other) noexcept
 		-> polymorphic_forward_list &
 	{
 		auto other_old = other.root.next;
 		other.root.next = nullptr;
-		auto old = root.next;
+		link old = root.next;
 		root.next = other_old;
-		if (old) delete old;
+		while (old.next)
+		{
+			PFL_POP(old.next);
+		}
 		return *this;
 	}
 
-	~polymorphic_forward_list() noexcept
+	PFL_CONSTEXPR ~polymorphic_forward_list() noexcept
 	{
 		while (root.next)
 		{
@@ -290,8 +752,8 @@ public:
 	{																	\
 		op																\
 		{																\
-			assign_before_end =											\
-				new node<Elem_Derived>(*assign_before_end, val);		\
+			assign_before_end = assign_before_end->next =				\
+				new node<Elem_Derived>(nullptr, val);					\
 		}																\
 	}																	\
 	catch (...)															\
@@ -312,7 +774,7 @@ public:
 		class InputIt,
 		class Elem_Derived = typename std::iterator_traits<InputIt>::value_type,
 		typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
-	polymorphic_forward_list(InputIt first, InputIt last) :
+	PFL_CONSTEXPR polymorphic_forward_list(InputIt first, InputIt last) :
 		root{ nullptr }
 	{
 		link assign_root = nullptr;
@@ -321,8 +783,8 @@ public:
 		{
 			while (first != last)
 			{
-				assign_before_end =
-					new node<Elem_Derived>(*assign_before_end, *first++);
+				assign_before_end = assign_before_end->next =
+					new node<Elem_Derived>(nullptr, *first++);
 			}
 		}
 		catch (...)
@@ -337,18 +799,93 @@ public:
 	}
 
 	template<class Elem_Derived>
-	void assign(size_type count, Elem_Derived const & value)
+	PFL_CONSTEXPR void assign(size_type count, Elem_Derived const & value)
 	{
 		PFL_ASSIGN(for (size_type i = 0; i < count; i++), value);
 	}
 
 	template<class InputIt, class Elem_Derived = typename std::iterator_traits<InputIt>::value_type>
-	auto assign(InputIt first, InputIt last)
+	PFL_CONSTEXPR auto assign(InputIt first, InputIt last)
 		-> std::enable_if_t<!std::is_integral_v<InputIt>>
 	{
 		PFL_ASSIGN(while (first != last), *first++);
 	}
 
+#if defined(PFL_ENABLE_PARALLEL) && defined(__cpp_lib_execution)
+	// Builds the nodes from a range with one thread per segment of the range
+	// when `policy` is a parallel policy, then links the segments in order.
+	// At most `max_threads` threads are used, or one per hardware thread when
+	// it is zero. If any element throws, every node built is destroyed and
+	// the first exception in range order is rethrown.
+#define PFL_ASSIGN_PARALLEL()											\
+	std::vector<parallel_segment> segments =							\
+		build_segments<Elem_Derived>(									\
+			is_parallel_policy<ExecutionPolicy> ? max_threads : 1,		\
+			first,														\
+			last);														\
+	link assign_root = nullptr;											\
+	link * assign_before_end = &assign_root;							\
+	std::exception_ptr error;											\
+	for (parallel_segment & segment : segments)							\
+	{																	\
+		if (!error) error = segment.error;								\
+		if (segment.root.next)											\
+		{																\
+			assign_before_end->next = segment.root.next;				\
+			assign_before_end = segment.before_end;						\
+		}																\
+	}																	\
+	if (error)															\
+	{																	\
+		while (assign_root.next)										\
+		{																\
+			PFL_POP(assign_root.next);									\
+		}																\
+		std::rethrow_exception(error);									\
+	}
+
+	template<
+		class ExecutionPolicy,
+		class ForwardIt,
+		class Elem_Derived =
+			typename std::iterator_traits<ForwardIt>::value_type,
+		typename = std::enable_if_t<
+			std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>>>
+	polymorphic_forward_list(
+		ExecutionPolicy &&,
+		ForwardIt first,
+		ForwardIt last,
+		size_type max_threads = 0) :
+		root{ nullptr }
+	{
+		PFL_ASSIGN_PARALLEL();
+		root.next = assign_root.next;
+	}
+
+	template<
+		class ExecutionPolicy,
+		class ForwardIt,
+		class Elem_Derived =
+			typename std::iterator_traits<ForwardIt>::value_type>
+	auto assign(
+		ExecutionPolicy &&,
+		ForwardIt first,
+		ForwardIt last,
+		size_type max_threads = 0)
+		-> std::enable_if_t<
+			std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>>
+	{
+		PFL_ASSIGN_PARALLEL();
+		while (root.next)
+		{
+			PFL_POP(root.next);
+		}
+		root.next = assign_root.next;
+	}
+
+#undef PFL_ASSIGN_PARALLEL
+#endif
+
 #undef PFL_ASSIGN
 
 	//--------------------------------------------------------------------------
@@ -357,11 +894,11 @@ public:
 	//
 	//--------------------------------------------------------------------------
 
-	PFL_NODISCARD auto front() noexcept -> reference
+	PFL_NODISCARD PFL_CONSTEXPR auto front() noexcept -> reference
 	{
 		return root.next->ref;
 	}
-	PFL_NODISCARD auto front() const noexcept -> const_reference
+	PFL_NODISCARD PFL_CONSTEXPR auto front() const noexcept -> const_reference
 	{
 		return root.next->ref;
 	}
@@ -372,52 +909,174 @@ public:
 	//
 	//--------------------------------------------------------------------------
 
-	PFL_NODISCARD auto before_begin() noexcept -> iterator
+	PFL_NODISCARD PFL_CONSTEXPR auto before_begin() noexcept -> iterator
 	{
 		return &root;
 	}
-	PFL_NODISCARD auto begin() noexcept -> iterator
+	PFL_NODISCARD PFL_CONSTEXPR auto begin() noexcept -> iterator
 	{
 		return root.next;
 	}
-	PFL_NODISCARD auto end() noexcept -> iterator
+	PFL_NODISCARD PFL_CONSTEXPR auto end() noexcept -> iterator
 	{
 		return nullptr;
 	}
 
-	PFL_NODISCARD auto before_begin() const noexcept -> const_iterator
+	PFL_NODISCARD PFL_CONSTEXPR auto before_begin() const noexcept
+		-> const_iterator
 	{
 		return const_cast<link *>(&root);
 	}
-	PFL_NODISCARD auto begin() const noexcept -> const_iterator
+	PFL_NODISCARD PFL_CONSTEXPR auto begin() const noexcept -> const_iterator
 	{
 		return root.next;
 	}
-	PFL_NODISCARD auto end() const noexcept -> const_iterator
+	PFL_NODISCARD PFL_CONSTEXPR auto end() const noexcept -> const_iterator
 	{
 		return nullptr;
 	}
 
-	PFL_NODISCARD auto cbefore_begin() const noexcept -> const_iterator
+	PFL_NODISCARD PFL_CONSTEXPR auto cbefore_begin() const noexcept
+		-> const_iterator
 	{
 		return const_cast<link *>(&root);
 	}
-	PFL_NODISCARD auto cbegin() const noexcept -> const_iterator
+	PFL_NODISCARD PFL_CONSTEXPR auto cbegin() const noexcept -> const_iterator
 	{
 		return root.next;
 	}
-	PFL_NODISCARD auto cend() const noexcept -> const_iterator
+	PFL_NODISCARD PFL_CONSTEXPR auto cend() const noexcept -> const_iterator
 	{
 		return nullptr;
 	}
 
 	//--------------------------------------------------------------------------
 	//
-	// Capacity
+	// Batched Traversal
 	//
 	//--------------------------------------------------------------------------
 
-	PFL_NODISCARD auto empty() const noexcept -> bool
+#ifdef __cpp_lib_span
+	// The largest batch whose element pointers are buffered on the stack.
+	// Larger batches are buffered on the heap.
+	static constexpr size_type stack_batch_size = 256;
+
+	// Gathers pointers to the elements whose nodes are exactly of type
+	// `node<Elem_Derived>` into a buffer of `batch_size` pointers, and calls
+	// `f` with a span of the buffer whenever it is full and once at the end.
+	// When `runs` is true, a node of another type also ends the batch.
+	// Throws `std::invalid_argument` if `batch_size` is zero.
+	//
+	// An element precedes the links of its node, so a large element may lie
+	// on cache lines the walk does not touch; each is prefetched when it is
+	// gathered, well before `f` reads it.
+#define PFL_FOR_EACH_BATCH(Elem, runs)									\
+	if (!batch_size)													\
+	{																	\
+		throw std::invalid_argument{ "batch_size must not be zero" };	\
+	}																	\
+	Elem * stack_batch[stack_batch_size];								\
+	std::vector<Elem *> heap_batch;										\
+	Elem ** batch = stack_batch;										\
+	if (batch_size > stack_batch_size)									\
+	{																	\
+		heap_batch.resize(batch_size);									\
+		batch = heap_batch.data();										\
+	}																	\
+	size_type count = 0;												\
+	for (basic_node * n = root.next; n; n = n->next)					\
+	{																	\
+		if (n->type_tag() == &node<Elem_Derived>::tag)					\
+		{																\
+			Elem * const elem =											\
+				&static_cast<node<Elem_Derived> *>(n)->elem;			\
+			PFL_PREFETCH(elem);											\
+			batch[count++] = elem;										\
+			if (count == batch_size)									\
+			{															\
+				f(std::span<Elem *>{ batch, count });					\
+				count = 0;												\
+			}															\
+		}																\
+		else if (runs && count)											\
+		{																\
+			f(std::span<Elem *>{ batch, count });						\
+			count = 0;													\
+		}																\
+	}																	\
+	if (count)															\
+	{																	\
+		f(std::span<Elem *>{ batch, count });							\
+	}
+
+	// Calls `f` with spans of pointers to every element of exact type
+	// `Elem_Derived`, in order. `f` must not modify the list.
+	template<class Elem_Derived, class Function>
+	void for_each_batch(Function f, size_type batch_size = stack_batch_size)
+	{
+		PFL_FOR_EACH_BATCH(Elem_Derived, false);
+	}
+	template<class Elem_Derived, class Function>
+	void for_each_batch(
+		Function f,
+		size_type batch_size = stack_batch_size) const
+	{
+		PFL_FOR_EACH_BATCH(Elem_Derived const, false);
+	}
+
+	// As `for_each_batch`, except that each span holds elements of adjacent
+	// nodes only.
+	template<class Elem_Derived, class Function>
+	void for_each_run(Function f, size_type batch_size = stack_batch_size)
+	{
+		PFL_FOR_EACH_BATCH(Elem_Derived, true);
+	}
+	template<class Elem_Derived, class Function>
+	void for_each_run(
+		Function f,
+		size_type batch_size = stack_batch_size) const
+	{
+		PFL_FOR_EACH_BATCH(Elem_Derived const, true);
+	}
+
+#undef PFL_FOR_EACH_BATCH
+
+	// Copies the member `field` of each element of `batch` to `out`, so that
+	// a kernel may operate on a structure of arrays.
+	template<class Pointer, class Member, class OutputIt>
+	static auto gather(std::span<Pointer> batch, Member field, OutputIt out)
+		-> OutputIt
+	{
+		for (Pointer p : batch)
+		{
+			*out = p->*field;
+			++out;
+		}
+		return out;
+	}
+
+	// Copies values from `in` back to the member `field` of each element of
+	// `batch`.
+	template<class Pointer, class Member, class InputIt>
+	static auto scatter(std::span<Pointer> batch, Member field, InputIt in)
+		-> InputIt
+	{
+		for (Pointer p : batch)
+		{
+			p->*field = *in;
+			++in;
+		}
+		return in;
+	}
+#endif
+
+	//--------------------------------------------------------------------------
+	//
+	// Capacity
+	//
+	//--------------------------------------------------------------------------
+
+	PFL_NODISCARD PFL_CONSTEXPR auto empty() const noexcept -> bool
 	{
 		return !root.next;
 	}
@@ -433,7 +1092,7 @@ public:
 	//
 	//--------------------------------------------------------------------------
 
-	void clear() noexcept
+	PFL_CONSTEXPR void clear() noexcept
 	{
 		while (root.next)
 		{
@@ -452,8 +1111,8 @@ public:
 	{																	\
 		op																\
 		{																\
-			insert_before_end											\
-				= new node<Elem_Derived>(*insert_before_end, val);		\
+			insert_before_end = insert_before_end->next =				\
+				new node<Elem_Derived>(nullptr, val);					\
 		}																\
 	}																	\
 	catch (...)															\
@@ -468,20 +1127,23 @@ public:
 	return insert_before_end;
 
 	template<class Elem_Derived>
-	auto insert_after(const_iterator pos, Elem_Derived const & value)
-		-> iterator
+	PFL_CONSTEXPR auto insert_after(
+		const_iterator pos,
+		Elem_Derived const & value) -> iterator
 	{
-		return new node<Elem_Derived>(*pos.p, value);
+		return pos.p->next = new node<Elem_Derived>(pos.p->next, value);
 	}
 
 	template<class Elem_Derived>
-	auto insert_after(const_iterator pos, Elem_Derived && value) -> iterator
+	PFL_CONSTEXPR auto insert_after(const_iterator pos, Elem_Derived && value)
+		-> iterator
 	{
-		return new node<Elem_Derived>(*pos.p, std::move(value));
+		return pos.p->next =
+			new node<Elem_Derived>(pos.p->next, std::move(value));
 	}
 
 	template<class Elem_Derived>
-	auto insert_after(
+	PFL_CONSTEXPR auto insert_after(
 		const_iterator pos,
 		size_type count,
 		Elem_Derived const & value) -> iterator
@@ -492,7 +1154,10 @@ public:
 	template<
 		class InputIt,
 		class Elem_Derived = typename std::iterator_traits<InputIt>::value_type>
-	auto insert_after(const_iterator pos, InputIt first, InputIt last)
+	PFL_CONSTEXPR auto insert_after(
+		const_iterator pos,
+		InputIt first,
+		InputIt last)
 		-> std::enable_if_t<!std::is_integral_v<InputIt>, iterator>
 	{
 		PFL_INSERT(while (first != last), *first++);
@@ -505,19 +1170,23 @@ public:
 	//--------------------------------------------------------------------------
 
 	template<class Elem_Derived = Elem_Base, class ... Args>
-	auto emplace_after(const_iterator pos, Args && ... args) -> iterator
+	PFL_CONSTEXPR auto emplace_after(const_iterator pos, Args && ... args)
+		-> iterator
 	{
-		return new node<Elem_Derived>(*pos.p, std::forward<Args>(args) ...);
+		return pos.p->next = new node<Elem_Derived>(
+			pos.p->next,
+			std::forward<Args>(args) ...);
 	}
 
-	auto erase_after(const_iterator pos) noexcept
+	PFL_CONSTEXPR auto erase_after(const_iterator pos) noexcept
 	{
 		PFL_POP(pos.p->next)
 			return pos.p->next;
 	}
 
-	auto erase_after(const_iterator first, const_iterator last) noexcept
-		-> iterator
+	PFL_CONSTEXPR auto erase_after(
+		const_iterator first,
+		const_iterator last) noexcept -> iterator
 	{
 		while ((first.p->next) != last.p)
 		{
@@ -531,31 +1200,32 @@ public:
 	//--------------------------------------------------------------------------
 
 	template<class Elem_Derived>
-	void push_front(Elem_Derived const & value)
+	PFL_CONSTEXPR void push_front(Elem_Derived const & value)
 	{
-		new node<Elem_Derived>(root, value);
+		root.next = new node<Elem_Derived>(root.next, value);
 	}
 
 	template<class Elem_Derived>
-	void push_front(Elem_Derived && value)
+	PFL_CONSTEXPR void push_front(Elem_Derived && value)
 	{
-		new node<Elem_Derived>(root, std::move(value));
+		root.next = new node<Elem_Derived>(root.next, std::move(value));
 	}
 
 	template<class Elem_Derived = Elem_Base, class ... Args>
-	auto emplace_front(Args && ... args) -> reference
+	PFL_CONSTEXPR auto emplace_front(Args && ... args) -> reference
 	{
-		basic_node * const new_node =
-			new node<Elem_Derived>(root, std::forward<Args>(args) ...);
-		return new_node->ref;
+		root.next = new node<Elem_Derived>(
+			root.next,
+			std::forward<Args>(args) ...);
+		return root.next->ref;
 	}
 
-	void pop_front()
+	PFL_CONSTEXPR void pop_front()
 	{
 		PFL_POP(root.next);
 	}
 
-	void swap(polymorphic_forward_list & other) noexcept
+	PFL_CONSTEXPR void swap(polymorphic_forward_list & other) noexcept
 	{
 		PFL_SWAP(root.next, other.root.next);
 	}
@@ -576,15 +1246,34 @@ public:
 	// Merges
 	//--------------------------------------------------------------------------
 
+// Runs of consecutive nodes from `other` which all precede the same node of
+// this list are spliced in with a single relink.
 #define PFL_MERGE(op)													\
 	if (this == &other) return;											\
 	if (!other.root.next) return;										\
+	auto const less = [&](basic_node const * a, basic_node const * b)	\
+	{																	\
+		return op;														\
+	};																	\
 	link * pivot = &root;												\
-	for (; pivot->next && other.root.next; pivot = pivot->next)			\
+	while (pivot->next && other.root.next)								\
 	{																	\
-		if (op)															\
+		if (less(other.root.next, pivot->next))							\
 		{																\
-			PFL_SPLICE_ONE(pivot->next, other.root.next);				\
+			basic_node * run_last = other.root.next;					\
+			while (run_last->next && less(run_last->next, pivot->next))	\
+			{															\
+				run_last = run_last->next;								\
+			}															\
+			basic_node * const saved = pivot->next;						\
+			pivot->next = other.root.next;								\
+			other.root.next = run_last->next;							\
+			run_last->next = saved;										\
+			pivot = saved;												\
+		}																\
+		else															\
+		{																\
+			pivot = pivot->next;										\
 		}																\
 	}																	\
 	if (other.root.next)												\
@@ -592,34 +1281,112 @@ public:
 		PFL_SWAP(other.root.next, pivot->next);							\
 	}
 
-	void merge(polymorphic_forward_list & other)
+	PFL_CONSTEXPR void merge(polymorphic_forward_list & other)
 		noexcept(noexcept(other.root.next->ref < root.next->ref))
 	{
-		PFL_MERGE(other.root.next->ref < pivot->next->ref);
+		PFL_MERGE(a->ref < b->ref);
 	}
 
-	void merge(polymorphic_forward_list && other)
+	PFL_CONSTEXPR void merge(polymorphic_forward_list && other)
 		noexcept(noexcept(other.root.next->ref < root.next->ref))
 	{
-		PFL_MERGE(other.root.next->ref < pivot->next->ref);
+		PFL_MERGE(a->ref < b->ref);
 	}
 
 	template<class Compare>
-	void merge(polymorphic_forward_list & other, Compare comp)
+	PFL_CONSTEXPR void merge(polymorphic_forward_list & other, Compare comp)
 		noexcept(noexcept(comp(other.root.next->ref, root.next->ref)))
 	{
-		PFL_MERGE(comp(other.root.next->ref, pivot->next->ref));
+		PFL_MERGE(comp(a->ref, b->ref));
 	}
 
 	template<class Compare>
-	void merge(polymorphic_forward_list && other, Compare comp)
+	PFL_CONSTEXPR void merge(polymorphic_forward_list && other, Compare comp)
 		noexcept(noexcept(comp(other.root.next->ref, root.next->ref)))
 	{
-		PFL_MERGE(comp(other.root.next->ref, pivot->next->ref));
+		PFL_MERGE(comp(a->ref, b->ref));
 	}
 
 #undef PFL_MERGE
 
+	// Merges every list in `lists` into this list with a k-way merge by
+	// relinking only, leaving the other lists empty. Equivalent elements keep
+	// the order of this list followed by the order of `lists`. If a comparison
+	// throws, every element is left in this list in unspecified order.
+	template<class Range>
+	void merge_all(Range && lists)
+	{
+		merge_all(
+			lists,
+			[](const_reference a, const_reference b) { return a < b; });
+	}
+
+	template<class Range, class Compare>
+	void merge_all(Range && lists, Compare comp)
+	{
+		std::vector<merge_source> heap;
+		size_type index = 0;
+		if (root.next) heap.push_back({ root.next, index });
+		for (polymorphic_forward_list & list : lists)
+		{
+			index++;
+			if (&list != this && list.root.next)
+			{
+				heap.push_back({ list.root.next, index });
+			}
+		}
+		for (polymorphic_forward_list & list : lists)
+		{
+			list.root.next = nullptr;
+		}
+		root.next = nullptr;
+
+		// `after(x, y)` if the head of `x` is merged after the head of `y`.
+		auto const after = [&](merge_source const & x, merge_source const & y)
+		{
+			return x.index < y.index
+				? comp(y.head->ref, x.head->ref)
+				: !comp(x.head->ref, y.head->ref);
+		};
+		link merge_root = nullptr;
+		link * merge_before_end = &merge_root;
+		try
+		{
+			for (size_type i = heap.size() / 2; i-- > 0;)
+			{
+				sift_down(heap, i, after);
+			}
+			while (heap.size() > 1)
+			{
+				merge_source & top = heap.front();
+				merge_before_end = merge_before_end->next = top.head;
+				top.head = top.head->next;
+				if (!top.head)
+				{
+					std::swap(top, heap.back());
+					heap.pop_back();
+				}
+				sift_down(heap, 0, after);
+			}
+		}
+		catch (...)
+		{
+			for (merge_source & source : heap)
+			{
+				merge_before_end->next = source.head;
+				while (merge_before_end->next)
+				{
+					merge_before_end = merge_before_end->next;
+				}
+			}
+			root.next = merge_root.next;
+			throw;
+		}
+		merge_before_end->next = heap.empty() ? nullptr : heap.front().head;
+		root.next = merge_root.next;
+	}
+
+
 	//--------------------------------------------------------------------------
 	// Splices
 	//--------------------------------------------------------------------------
@@ -631,24 +1398,27 @@ public:
 	while (condition) a = a->next;										\
 	a->next = saved;
 
-	void splice_after(const_iterator pos, polymorphic_forward_list & other)
-		noexcept
+	PFL_CONSTEXPR void splice_after(
+		const_iterator pos,
+		polymorphic_forward_list & other) noexcept
 	{
 		PFL_SPLICE(pos.p, other.root.next, nullptr, pos.p->next);
 	}
 
-	void splice_after(const_iterator pos, polymorphic_forward_list && other)
-		noexcept
+	PFL_CONSTEXPR void splice_after(
+		const_iterator pos,
+		polymorphic_forward_list && other) noexcept
 	{
 		PFL_SPLICE(pos.p, other.root.next, nullptr, pos.p->next);
 	}
 
-	void splice_after(const_iterator pos, const_iterator it) noexcept
+	PFL_CONSTEXPR void splice_after(const_iterator pos, const_iterator it)
+		noexcept
 	{
 		PFL_SPLICE_ONE(pos.p->next, it.p->next);
 	}
 
-	void splice_after(
+	PFL_CONSTEXPR void splice_after(
 		const_iterator pos,
 		const_iterator first,
 		const_iterator last)
@@ -679,18 +1449,18 @@ public:
 	}																	\
 	return removed_count;
 
-	auto remove(const_reference value) -> size_type
+	PFL_CONSTEXPR auto remove(const_reference value) -> size_type
 	{
 		PFL_REMOVE(pivot->next->ref == value);
 	}
 
 	template<class UnaryPredicate>
-	auto remove_if(UnaryPredicate p) -> size_type
+	PFL_CONSTEXPR auto remove_if(UnaryPredicate p) -> size_type
 	{
 		PFL_REMOVE(p(pivot->next->ref));
 	}
 
-	void reverse() noexcept
+	PFL_CONSTEXPR void reverse() noexcept
 	{
 		link reverse_root = nullptr;
 		while (root.next)
@@ -702,125 +1472,598 @@ public:
 
 #undef PFL_REMOVE
 
-#undef PFL_SPLICE_ONE
+	//--------------------------------------------------------------------------
+	// Duplicate Removal
+	//--------------------------------------------------------------------------
 
-#undef PFL_POP
-#undef PFL_SWAP
+	// Duplicates are unlinked into a trash chain during the scan and destroyed
+	// together after it, so that destruction does not interleave with the
+	// comparisons. If a comparison throws, the duplicates found so far are
+	// still removed.
 
-private:
-	link root;
-};
+#define PFL_DISCARD(pivot)												\
+	basic_node * const duplicate = pivot->next;							\
+	pivot->next = duplicate->next;										\
+	trash_end = trash_end->next = duplicate;							\
+	removed_count++;
 
-//------------------------------------------------------------------------------
-//
-//
-// Non-member Functions
-//
-//
-//------------------------------------------------------------------------------
+#define PFL_RELEASE_TRASH()												\
+	trash_end->next = nullptr;											\
+	while (trash_root.next)												\
+	{																	\
+		PFL_POP(trash_root.next);										\
+	}
 
-template<class T>
-PFL_NODISCARD auto operator==(
-	polymorphic_forward_list<T> const & lhs,
-	polymorphic_forward_list<T> const & rhs)
-	noexcept(noexcept(*lhs.begin() == *rhs.begin()))
-	-> bool
-{
-	auto left = lhs.begin();
-	auto right = rhs.begin();
-	auto const end = lhs.end();
-	for (;;)
+#define PFL_UNIQUE(op)													\
+	size_type removed_count = 0;										\
+	link trash_root = nullptr;											\
+	link * trash_end = &trash_root;										\
+	try																	\
+	{																	\
+		for (basic_node * pivot = root.next; pivot && pivot->next;)		\
+		{																\
+			if (op)														\
+			{															\
+				PFL_DISCARD(pivot);										\
+			}															\
+			else														\
+			{															\
+				pivot = pivot->next;									\
+			}															\
+		}																\
+	}																	\
+	catch (...)															\
+	{																	\
+		PFL_RELEASE_TRASH();											\
+		throw;															\
+	}																	\
+	PFL_RELEASE_TRASH();												\
+	return removed_count;
+
+	PFL_CONSTEXPR auto unique() -> size_type
 	{
-		if (left == end)
+		PFL_UNIQUE(pivot->ref == pivot->next->ref);
+	}
+
+	template<class BinaryPredicate>
+	PFL_CONSTEXPR auto unique(BinaryPredicate p) -> size_type
+	{
+		PFL_UNIQUE(p(pivot->ref, pivot->next->ref));
+	}
+
+	// Removes every element equal to an earlier element, in a single pass.
+	// The retained nodes are kept in a transient open addressing table with
+	// linear probing, which is doubled whenever it would become half full.
+	template<class Hash, class KeyEqual>
+	auto dedup(Hash hash, KeyEqual eq) -> size_type
+	{
+		struct slot
 		{
-			return right == end;
+			basic_node * node;
+			std::size_t hash;
+		};
+
+		// Fibonacci hashing spreads hashes which differ only in high bits.
+		auto const home = [](std::size_t h, int shift) -> std::size_t
+		{
+			return static_cast<std::size_t>(
+				(static_cast<std::uint64_t>(h) * 0x9E3779B97F4A7C15u) >> shift);
+		};
+
+		size_type removed_count = 0;
+		link trash_root = nullptr;
+		link * trash_end = &trash_root;
+		try
+		{
+			int shift = 64 - 4;
+			std::vector<slot> table(std::size_t{ 1 } << (64 - shift));
+			std::size_t mask = table.size() - 1;
+			size_type retained = 0;
+			for (link * pivot = &root; pivot->next;)
+			{
+				basic_node * const candidate = pivot->next;
+				std::size_t const h = hash(
+					static_cast<const_reference>(candidate->ref));
+				std::size_t i = home(h, shift);
+				bool found = false;
+				for (; table[i].node; i = (i + 1) & mask)
+				{
+					if (table[i].hash == h && eq(
+						static_cast<const_reference>(table[i].node->ref),
+						static_cast<const_reference>(candidate->ref)))
+					{
+						found = true;
+						break;
+					}
+				}
+				if (found)
+				{
+					PFL_DISCARD(pivot);
+					continue;
+				}
+				if (2 * (retained + 1) > table.size())
+				{
+					std::vector<slot> grown(2 * table.size());
+					shift--;
+					mask = grown.size() - 1;
+					for (slot const & s : table)
+					{
+						if (s.node)
+						{
+							std::size_t j = home(s.hash, shift);
+							while (grown[j].node) j = (j + 1) & mask;
+							grown[j] = s;
+						}
+					}
+					table.swap(grown);
+					i = home(h, shift);
+					while (table[i].node) i = (i + 1) & mask;
+				}
+				table[i] = slot{ candidate, h };
+				retained++;
+				pivot = candidate;
+			}
 		}
-		if (right == end)
+		catch (...)
 		{
-			return false;
+			PFL_RELEASE_TRASH();
+			throw;
 		}
-		if (!(*left++ == *right++)) return false;
+		PFL_RELEASE_TRASH();
+		return removed_count;
 	}
-}
-template<class T>
-PFL_NODISCARD auto operator!=(
-	polymorphic_forward_list<T> const & lhs,
-	polymorphic_forward_list<T> const & rhs)
-	noexcept(noexcept(*lhs.begin() == *rhs.begin()))
-	-> bool
-{
-	auto left = lhs.begin();
-	auto right = rhs.begin();
-	auto const end = lhs.end();
-	for (;;)
+
+	template<class Hash>
+	auto dedup(Hash hash) -> size_type
 	{
-		if (left == end)
+		return dedup(std::move(hash), [](const_reference a, const_reference b)
 		{
-			return right != end;
+			return a == b;
+		});
+	}
+
+#undef PFL_UNIQUE
+#undef PFL_RELEASE_TRASH
+#undef PFL_DISCARD
+
+	//--------------------------------------------------------------------------
+	// Incremental Operations
+	//--------------------------------------------------------------------------
+
+	// A resumable operation which processes a bounded number of nodes per
+	// step. The list is valid between steps, and elements may be pushed to its
+	// front; any other modification of the lists involved invalidates the job.
+	// A job must not outlive the lists it refers to.
+	template<class Operation>
+	class incremental_job
+	{
+		friend class polymorphic_forward_list;
+
+	public:
+		// The number of nodes processed between reads of the clock.
+		static constexpr size_type deadline_stride = 32;
+
+		// Processes at most `max_nodes` nodes and returns whether the job is
+		// done.
+		auto step(size_type max_nodes) -> bool
+		{
+			while (!finished && max_nodes--)
+			{
+				finished = !operation();
+			}
+			return finished;
 		}
-		if (right == end)
+
+		// Processes nodes until the job is done or `deadline` has passed, and
+		// returns whether the job is done.
+		template<class Clock, class Duration>
+		auto step_until(
+			std::chrono::time_point<Clock, Duration> const & deadline)
+			-> bool
 		{
-			return true;
+			while (!step(deadline_stride) && Clock::now() < deadline);
+			return finished;
 		}
-		if (!(*left++ == *right++)) return true;
-	}
-}
-template<class T>
-PFL_NODISCARD auto operator<(
-	polymorphic_forward_list<T> const & lhs,
-	polymorphic_forward_list<T> const & rhs)
-	noexcept(
-		noexcept(*lhs.begin() < *rhs.begin()) &&
-		noexcept(*rhs.begin() < *lhs.begin()))
-	-> bool
-{
-	auto left = lhs.begin();
-	auto right = rhs.begin();
-	auto const end = lhs.end();
-	for (;;)
-	{
-		if (left == end)
+
+		PFL_NODISCARD auto done() const noexcept -> bool
 		{
-			return right != end;
+			return finished;
 		}
-		if (right == end)
+
+		PFL_NODISCARD auto result() const noexcept
 		{
-			return false;
+			return operation.result();
 		}
-		if (*left < *right) return true;
-		if (*right++ < *left++) return false;
-	}
-}
-template<class T>
-PFL_NODISCARD auto operator>=(
-	polymorphic_forward_list<T> const & lhs,
-	polymorphic_forward_list<T> const & rhs)
-	noexcept(
-		noexcept(*lhs.begin() < *rhs.begin()) &&
-		noexcept(*rhs.begin() < *lhs.begin()))
-	-> bool
-{
-	auto left = lhs.begin();
-	auto right = rhs.begin();
-	auto const end = lhs.end();
-	for (;;)
+
+	private:
+		Operation operation;
+		bool finished = false;
+
+		incremental_job(Operation operation) :
+			operation{ std::move(operation) }
+		{ }
+	};
+
+private:
+
+	// Each operation processes one node per call, and returns false when no
+	// node was left to process.
+
+	// Owns the chain detached from the list, and destroys any nodes left in
+	// it when the job is destroyed.
+	struct clear_operation
 	{
-		if (left == end)
+		clear_operation(basic_node * chain) noexcept :
+			chain{ chain }
+		{ }
+
+		clear_operation(clear_operation && other) noexcept :
+			chain{ other.chain.next }
 		{
-			return right == end;
+			other.chain.next = nullptr;
 		}
-		if (right == end)
+
+		auto operator=(clear_operation &&)->clear_operation & = delete;
+
+		~clear_operation() noexcept
+		{
+			while (chain.next)
+			{
+				PFL_POP(chain.next);
+			}
+		}
+
+		auto operator()() noexcept -> bool
 		{
+			if (!chain.next) return false;
+			PFL_POP(chain.next);
 			return true;
 		}
-		if (*left < *right) return false;
-		if (*right++ < *left++) return true;
-	}
-}
-template<class T>
-PFL_NODISCARD auto operator>(
-	polymorphic_forward_list<T> const & lhs,
-	polymorphic_forward_list<T> const & rhs)
+
+		link chain;
+	};
+
+	template<class UnaryPredicate>
+	struct remove_if_operation
+	{
+		auto operator()() -> bool
+		{
+			if (!pivot->next) return false;
+			if (p(pivot->next->ref))
+			{
+				PFL_POP(pivot->next);
+				removed_count++;
+			}
+			else
+			{
+				pivot = pivot->next;
+			}
+			return true;
+		}
+
+		auto result() const noexcept -> size_type
+		{
+			return removed_count;
+		}
+
+		link * pivot;
+		UnaryPredicate p;
+		size_type removed_count;
+	};
+
+	template<class Compare>
+	struct merge_operation
+	{
+		auto operator()() -> bool
+		{
+			if (!other || !other->root.next) return false;
+			if (!pivot->next)
+			{
+				PFL_SWAP(other->root.next, pivot->next);
+				return false;
+			}
+			if (comp(other->root.next->ref, pivot->next->ref))
+			{
+				PFL_SPLICE_ONE(pivot->next, other->root.next);
+			}
+			pivot = pivot->next;
+			return true;
+		}
+
+		link * pivot;
+		polymorphic_forward_list * other;
+		Compare comp;
+	};
+
+public:
+
+	// Empties the list at once. The job destroys the detached elements, so
+	// elements inserted afterwards are untouched by it.
+	PFL_NODISCARD auto clear_incremental() noexcept
+		-> incremental_job<clear_operation>
+	{
+		basic_node * const chain = root.next;
+		root.next = nullptr;
+		return clear_operation{ chain };
+	}
+
+	// `result()` is the number of elements removed so far.
+	template<class UnaryPredicate>
+	PFL_NODISCARD auto remove_if_incremental(UnaryPredicate p)
+		-> incremental_job<remove_if_operation<UnaryPredicate>>
+	{
+		return remove_if_operation<UnaryPredicate>{ &root, std::move(p), 0 };
+	}
+
+	PFL_NODISCARD auto merge_incremental(polymorphic_forward_list & other)
+	{
+		return merge_incremental(
+			other,
+			[](const_reference a, const_reference b) { return a < b; });
+	}
+
+	template<class Compare>
+	PFL_NODISCARD auto merge_incremental(
+		polymorphic_forward_list & other,
+		Compare comp) -> incremental_job<merge_operation<Compare>>
+	{
+		return merge_operation<Compare>{
+			&root,
+			&other == this ? nullptr : &other,
+			std::move(comp) };
+	}
+
+#undef PFL_SPLICE_ONE
+
+#undef PFL_POP
+#undef PFL_SWAP
+
+private:
+	link root;
+
+	struct merge_source
+	{
+		basic_node * head;
+		size_type index;
+	};
+
+	// Only swaps sources, so that the heap keeps every source if `after`
+	// throws.
+	template<class After>
+	static void sift_down(
+		std::vector<merge_source> & heap,
+		size_type i,
+		After const & after)
+	{
+		for (;;)
+		{
+			size_type child = 2 * i + 1;
+			if (child >= heap.size()) return;
+			if (child + 1 < heap.size() && after(heap[child], heap[child + 1]))
+			{
+				child++;
+			}
+			if (!after(heap[i], heap[child])) return;
+			std::swap(heap[i], heap[child]);
+			i = child;
+		}
+	}
+
+#if defined(PFL_ENABLE_PARALLEL) && defined(__cpp_lib_execution)
+	// The minimum number of elements built by each thread of a parallel
+	// construction.
+	static constexpr size_type parallel_grain = 4096;
+
+	template<class ExecutionPolicy>
+	static constexpr bool is_parallel_policy =
+		std::is_same_v<
+			std::decay_t<ExecutionPolicy>,
+			std::execution::parallel_policy> ||
+		std::is_same_v<
+			std::decay_t<ExecutionPolicy>,
+			std::execution::parallel_unsequenced_policy>;
+
+	// A chain of nodes built by one thread, holding the nodes built before
+	// any exception it records.
+	struct parallel_segment
+	{
+		link root{ nullptr };
+		link * before_end = &root;
+		std::exception_ptr error;
+	};
+
+	template<class Elem_Derived, class ForwardIt>
+	static void build_segment(
+		ForwardIt first,
+		ForwardIt last,
+		parallel_segment * segment) noexcept
+	{
+		try
+		{
+			while (first != last)
+			{
+				segment->before_end = segment->before_end->next =
+					new node<Elem_Derived>(nullptr, *first++);
+			}
+		}
+		catch (...)
+		{
+			segment->error = std::current_exception();
+		}
+	}
+
+	// Uses up to `threads` threads, or one per hardware thread when it is
+	// zero. The last segment is built by the calling thread. A thread which
+	// cannot be started records its exception in its segment, and no later
+	// segment is built.
+	template<class Elem_Derived, class ForwardIt>
+	static auto build_segments(
+		size_type threads,
+		ForwardIt first,
+		ForwardIt last)
+		-> std::vector<parallel_segment>
+	{
+		static_assert(std::is_base_of_v<
+			std::forward_iterator_tag,
+			typename std::iterator_traits<ForwardIt>::iterator_category>,
+			"A parallel construction requires forward iterators.");
+
+		size_type const size = static_cast<size_type>(
+			std::distance(first, last));
+		size_type count = threads;
+		if (count == 0) count = std::thread::hardware_concurrency();
+		if (count > size / parallel_grain) count = size / parallel_grain;
+		if (count == 0) count = 1;
+
+		std::vector<parallel_segment> segments(count);
+		std::vector<std::thread> workers;
+		workers.reserve(count - 1);
+		bool started = true;
+		for (size_type i = 0; i + 1 < count; i++)
+		{
+			ForwardIt const segment_last = std::next(
+				first,
+				static_cast<std::ptrdiff_t>(
+					size / count + (i < size % count ? 1 : 0)));
+			try
+			{
+				workers.emplace_back(
+					&build_segment<Elem_Derived, ForwardIt>,
+					first,
+					segment_last,
+					&segments[i]);
+			}
+			catch (...)
+			{
+				segments[i].error = std::current_exception();
+				started = false;
+				break;
+			}
+			first = segment_last;
+		}
+		if (started)
+		{
+			build_segment<Elem_Derived>(first, last, &segments.back());
+		}
+		for (std::thread & worker : workers)
+		{
+			worker.join();
+		}
+		return segments;
+	}
+#endif
+};
+
+//------------------------------------------------------------------------------
+//
+//
+// Non-member Functions
+//
+//
+//------------------------------------------------------------------------------
+
+template<class T, class A>
+PFL_NODISCARD auto operator==(
+	polymorphic_forward_list<T, A> const & lhs,
+	polymorphic_forward_list<T, A> const & rhs)
+	noexcept(noexcept(*lhs.begin() == *rhs.begin()))
+	-> bool
+{
+	auto left = lhs.begin();
+	auto right = rhs.begin();
+	auto const end = lhs.end();
+	for (;;)
+	{
+		if (left == end)
+		{
+			return right == end;
+		}
+		if (right == end)
+		{
+			return false;
+		}
+		if (!(*left++ == *right++)) return false;
+	}
+}
+template<class T, class A>
+PFL_NODISCARD auto operator!=(
+	polymorphic_forward_list<T, A> const & lhs,
+	polymorphic_forward_list<T, A> const & rhs)
+	noexcept(noexcept(*lhs.begin() == *rhs.begin()))
+	-> bool
+{
+	auto left = lhs.begin();
+	auto right = rhs.begin();
+	auto const end = lhs.end();
+	for (;;)
+	{
+		if (left == end)
+		{
+			return right != end;
+		}
+		if (right == end)
+		{
+			return true;
+		}
+		if (!(*left++ == *right++)) return true;
+	}
+}
+template<class T, class A>
+PFL_NODISCARD auto operator<(
+	polymorphic_forward_list<T, A> const & lhs,
+	polymorphic_forward_list<T, A> const & rhs)
+	noexcept(
+		noexcept(*lhs.begin() < *rhs.begin()) &&
+		noexcept(*rhs.begin() < *lhs.begin()))
+	-> bool
+{
+	auto left = lhs.begin();
+	auto right = rhs.begin();
+	auto const end = lhs.end();
+	for (;;)
+	{
+		if (left == end)
+		{
+			return right != end;
+		}
+		if (right == end)
+		{
+			return false;
+		}
+		if (*left < *right) return true;
+		if (*right++ < *left++) return false;
+	}
+}
+template<class T, class A>
+PFL_NODISCARD auto operator>=(
+	polymorphic_forward_list<T, A> const & lhs,
+	polymorphic_forward_list<T, A> const & rhs)
+	noexcept(
+		noexcept(*lhs.begin() < *rhs.begin()) &&
+		noexcept(*rhs.begin() < *lhs.begin()))
+	-> bool
+{
+	auto left = lhs.begin();
+	auto right = rhs.begin();
+	auto const end = lhs.end();
+	for (;;)
+	{
+		if (left == end)
+		{
+			return right == end;
+		}
+		if (right == end)
+		{
+			return true;
+		}
+		if (*left < *right) return false;
+		if (*right++ < *left++) return true;
+	}
+}
+template<class T, class A>
+PFL_NODISCARD auto operator>(
+	polymorphic_forward_list<T, A> const & lhs,
+	polymorphic_forward_list<T, A> const & rhs)
 	noexcept(
 		noexcept(*lhs.begin() < *rhs.begin()) &&
 		noexcept(*rhs.begin() < *lhs.begin()))
@@ -843,10 +2086,10 @@ PFL_NODISCARD auto operator>(
 		if (*left++ < *right++) return false;
 	}
 }
-template<class T>
+template<class T, class A>
 PFL_NODISCARD auto operator<=(
-	polymorphic_forward_list<T> const & lhs,
-	polymorphic_forward_list<T> const & rhs)
+	polymorphic_forward_list<T, A> const & lhs,
+	polymorphic_forward_list<T, A> const & rhs)
 	noexcept(
 		noexcept(*lhs.begin() < *rhs.begin()) &&
 		noexcept(*rhs.begin() < *lhs.begin()))
@@ -870,6 +2113,1938 @@ PFL_NODISCARD auto operator<=(
 	}
 }
 
+//------------------------------------------------------------------------------
+//
+//
+// Shared List
+//
+//
+//------------------------------------------------------------------------------
+
+// A persistent polymorphic_forward_list whose immutable nodes are reference
+// counted and shared between lists. Copying a list, or taking a `snapshot`, is
+// O(1). Insertion and erasure after a position copy only the nodes from the
+// first shared node up to that position, so the tail is always shared.
+//
+// A list object is not itself thread safe, but the nodes are: a snapshot
+// taken by the modifying thread may be handed to and read from another
+// thread while the original list continues to be modified, and neither side
+// blocks the other. Elements are immutable once inserted, and element types
+// must be copy constructible.
+template<class Elem_Base, class Node_Allocator = default_node_allocator>
+class shared_polymorphic_forward_list
+{
+public:
+	using value_type = Elem_Base;
+	using size_type = size_t;
+	using difference_type = void;
+	using reference = value_type const &;
+	using const_reference = value_type const &;
+	using pointer = value_type const *;
+	using const_pointer = value_type const *;
+
+private:
+
+	//--------------------------------------------------------------------------
+	//
+	//
+	// Node Types
+	//
+	//
+	//--------------------------------------------------------------------------
+
+	struct basic_node;
+
+	struct link
+	{
+		link() = delete;
+		link(link const &) = delete;
+		link(link &&) = delete;
+		auto operator=(link const &)->link & = delete;
+		auto operator=(link &&)->link & = delete;
+		~link() = default;
+
+		link(basic_node * next) noexcept :
+			next{ next }
+		{ }
+
+		basic_node * next;
+	};
+
+	struct basic_node : link, polymorphic_node_allocation<Node_Allocator>
+	{
+		// Takes ownership of the reference `after` holds to its successor.
+		basic_node(link & after, const_reference ref) noexcept :
+			link{ after.next },
+			refs{ 1 },
+			ref{ ref }
+		{
+			after.next = this;
+		}
+
+		virtual ~basic_node() noexcept = default;
+
+		// Copies this node into a new node after `after`, which must not own
+		// a successor. The copy shares this node's successor.
+		virtual void clone(link & after) const = 0;
+
+		std::atomic<size_type> mutable refs;
+		const_reference ref;
+	};
+
+	template<class Elem_Derived>
+	struct basic_owner
+	{
+		template<class ... Args>
+		basic_owner(Args && ... args)
+			noexcept(noexcept(Elem_Derived{ std::forward<Args>(args) ... })) :
+			elem{ std::forward<Args>(args) ... }
+		{ }
+
+		Elem_Derived const elem;
+	};
+
+	template<class Elem_Derived>
+	struct node : basic_owner<Elem_Derived>, basic_node
+	{
+		template<class ... Args>
+		node(link & after, Args && ... args)
+			noexcept(noexcept(Elem_Derived{ std::forward<Args>(args) ... })) :
+			basic_owner<Elem_Derived>{ std::forward<Args>(args) ... },
+			basic_node{ after, basic_owner<Elem_Derived>::elem }
+		{ }
+
+		void clone(link & after) const override
+		{
+			new node(after, basic_owner<Elem_Derived>::elem);
+			acquire(after.next->next = this->next);
+		}
+	};
+
+	static void acquire(basic_node * n) noexcept
+	{
+		if (n) n->refs.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	static void release(basic_node * n) noexcept
+	{
+		while (n && n->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			basic_node * const trash = n;
+			n = trash->next;
+			delete trash;
+		}
+	}
+
+public:
+
+	//--------------------------------------------------------------------------
+	//
+	//
+	// Iterator Types
+	//
+	//
+	//--------------------------------------------------------------------------
+
+	class const_iterator
+	{
+		friend class shared_polymorphic_forward_list;
+
+	public:
+		using difference_type = void;
+		using value_type = value_type;
+		using pointer = const_pointer;
+		using reference = const_reference;
+		using iterator_category = std::forward_iterator_tag;
+
+		const_iterator() noexcept = default;
+		const_iterator(const_iterator const &) noexcept = default;
+		auto operator=(const_iterator const &) noexcept
+			->const_iterator & = default;
+
+		auto operator*() const noexcept -> reference
+		{
+			return static_cast<basic_node const &>(*p).ref;
+		}
+		auto operator->() const noexcept -> pointer
+		{
+			return &static_cast<basic_node const &>(*p).ref;
+		}
+
+		auto operator++() noexcept -> const_iterator &
+		{
+			p = p->next;
+			return *this;
+		}
+		auto operator++(int) noexcept -> const_iterator
+		{
+			const_iterator copy = *this;
+			p = p->next;
+			return copy;
+		}
+
+		auto operator!=(const_iterator const & other) noexcept -> bool
+		{
+			return p != other.p;
+		}
+		auto operator==(const_iterator const & other) noexcept -> bool
+		{
+			return p == other.p;
+		}
+
+	private:
+		link const * p = nullptr;
+
+		const_iterator(link const * p) noexcept :
+			p{ p }
+		{ }
+	};
+
+	using iterator = const_iterator;
+
+	//--------------------------------------------------------------------------
+	//
+	//
+	// Member Functions
+	//
+	//
+	//--------------------------------------------------------------------------
+
+	//--------------------------------------------------------------------------
+	//
+	// Constructors / Assignment Operators
+	//
+	//--------------------------------------------------------------------------
+
+	shared_polymorphic_forward_list() noexcept :
+		root{ nullptr }
+	{}
+
+	shared_polymorphic_forward_list(
+		shared_polymorphic_forward_list const & other) noexcept :
+		root{ other.root.next }
+	{
+		acquire(root.next);
+	}
+
+	shared_polymorphic_forward_list(
+		shared_polymorphic_forward_list && other) noexcept :
+		root{ other.root.next }
+	{
+		other.root.next = nullptr;
+	}
+
+	auto operator=(shared_polymorphic_forward_list const & other) noexcept
+		-> shared_polymorphic_forward_list &
+	{
+		acquire(other.root.next);
+		release(root.next);
+		root.next = other.root.next;
+		return *this;
+	}
+
+	auto operator=(shared_polymorphic_forward_list && other) noexcept
+		-> shared_polymorphic_forward_list &
+	{
+		auto other_old = other.root.next;
+		other.root.next = nullptr;
+		release(root.next);
+		root.next = other_old;
+		return *this;
+	}
+
+	~shared_polymorphic_forward_list() noexcept
+	{
+		release(root.next);
+	}
+
+	//--------------------------------------------------------------------------
+	//
+	// Snapshots
+	//
+	//--------------------------------------------------------------------------
+
+	// Must be called by the thread which modifies the list, or while no thread
+	// modifies it. The head is read without synchronization, so another
+	// thread must receive the snapshot rather than take it.
+	PFL_NODISCARD auto snapshot() const noexcept
+		-> shared_polymorphic_forward_list
+	{
+		return *this;
+	}
+
+	//--------------------------------------------------------------------------
+	//
+	// Element Access
+	//
+	//--------------------------------------------------------------------------
+
+	PFL_NODISCARD auto front() const noexcept -> const_reference
+	{
+		return root.next->ref;
+	}
+
+	//--------------------------------------------------------------------------
+	//
+	// Iterators
+	//
+	//--------------------------------------------------------------------------
+
+	PFL_NODISCARD auto before_begin() const noexcept -> const_iterator
+	{
+		return &root;
+	}
+	PFL_NODISCARD auto begin() const noexcept -> const_iterator
+	{
+		return root.next;
+	}
+	PFL_NODISCARD auto end() const noexcept -> const_iterator
+	{
+		return nullptr;
+	}
+
+	PFL_NODISCARD auto cbefore_begin() const noexcept -> const_iterator
+	{
+		return &root;
+	}
+	PFL_NODISCARD auto cbegin() const noexcept -> const_iterator
+	{
+		return root.next;
+	}
+	PFL_NODISCARD auto cend() const noexcept -> const_iterator
+	{
+		return nullptr;
+	}
+
+	//--------------------------------------------------------------------------
+	//
+	// Capacity
+	//
+	//--------------------------------------------------------------------------
+
+	PFL_NODISCARD auto empty() const noexcept -> bool
+	{
+		return !root.next;
+	}
+
+	PFL_NODISCARD auto max_size() const noexcept -> size_type
+	{
+		return std::numeric_limits<size_type>::max();
+	}
+
+	//--------------------------------------------------------------------------
+	//
+	// Modifiers
+	//
+	//--------------------------------------------------------------------------
+
+	void clear() noexcept
+	{
+		release(root.next);
+		root.next = nullptr;
+	}
+
+	template<class Elem_Derived>
+	auto insert_after(const_iterator pos, Elem_Derived const & value)
+		-> iterator
+	{
+		link & after = own_through(pos.p);
+		return new node<Elem_Derived>(after, value);
+	}
+
+	template<class Elem_Derived = Elem_Base, class ... Args>
+	auto emplace_after(const_iterator pos, Args && ... args) -> iterator
+	{
+		link & after = own_through(pos.p);
+		return new node<Elem_Derived>(after, std::forward<Args>(args) ...);
+	}
+
+	auto erase_after(const_iterator pos) -> iterator
+	{
+		link & after = own_through(pos.p);
+		basic_node * const trash = after.next;
+		acquire(after.next = trash->next);
+		release(trash);
+		return after.next;
+	}
+
+	template<class Elem_Derived>
+	void push_front(Elem_Derived const & value)
+	{
+		new node<Elem_Derived>(root, value);
+	}
+
+	template<class Elem_Derived = Elem_Base, class ... Args>
+	auto emplace_front(Args && ... args) -> const_reference
+	{
+		basic_node * const new_node =
+			new node<Elem_Derived>(root, std::forward<Args>(args) ...);
+		return new_node->ref;
+	}
+
+	void pop_front() noexcept
+	{
+		basic_node * const trash = root.next;
+		acquire(root.next = trash->next);
+		release(trash);
+	}
+
+	void swap(shared_polymorphic_forward_list & other) noexcept
+	{
+		basic_node * const saved = root.next;
+		root.next = other.root.next;
+		other.root.next = saved;
+	}
+
+private:
+	link root;
+
+	// Makes every node from the front up to and including `pos` owned by this
+	// list alone, copying from the first node which is shared, and returns the
+	// link corresponding to `pos`.
+	auto own_through(link const * pos) -> link &
+	{
+		link * pivot = &root;
+		link const * original = &root;
+		while (original != pos &&
+			pivot->next->refs.load(std::memory_order_acquire) == 1)
+		{
+			original = pivot = pivot->next;
+		}
+		while (original != pos)
+		{
+			basic_node * const shared = pivot->next;
+			pivot->next = nullptr;
+			try
+			{
+				shared->clone(*pivot);
+			}
+			catch (...)
+			{
+				pivot->next = shared;
+				throw;
+			}
+			release(shared);
+			original = shared;
+			pivot = pivot->next;
+		}
+		return *pivot;
+	}
+};
+
+//------------------------------------------------------------------------------
+//
+//
+// Arena List
+//
+//
+//------------------------------------------------------------------------------
+
+// A contiguous region of fixed capacity from which the nodes of
+// `arena_polymorphic_forward_list`s are allocated. Nodes are addressed by
+// 32-bit offsets from the base of the arena in units of `granularity` bytes,
+// so an arena holds at most 32 GiB. An arena must outlive its lists.
+class polymorphic_node_arena
+{
+public:
+	static constexpr size_t granularity = 8;
+
+	polymorphic_node_arena(polymorphic_node_arena const &) = delete;
+	auto operator=(polymorphic_node_arena const &)
+		->polymorphic_node_arena & = delete;
+
+	explicit polymorphic_node_arena(size_t capacity) :
+		capacity_granules{ checked_capacity(capacity) },
+		base{ static_cast<char *>(::operator new(capacity)) }
+	{ }
+
+	~polymorphic_node_arena() noexcept
+	{
+		::operator delete(base);
+	}
+
+	// Returns a nonzero offset, or throws `std::bad_alloc` when the arena is
+	// exhausted.
+	auto allocate(size_t size) -> std::uint32_t
+	{
+		std::uint32_t const granules = granules_of(size);
+		std::uint32_t * head = &large;
+		if (granules <= bucket_count)
+		{
+			head = &buckets[granules - 1];
+		}
+		else
+		{
+			while (*head && block(*head)->granules != granules)
+			{
+				head = &block(*head)->next;
+			}
+		}
+		if (std::uint32_t const offset = *head)
+		{
+			*head = block(offset)->next;
+			return offset;
+		}
+		if (capacity_granules - top < granules) throw std::bad_alloc{};
+		std::uint32_t const offset = top;
+		top += granules;
+		return offset;
+	}
+
+	void deallocate(std::uint32_t offset, size_t size) noexcept
+	{
+		std::uint32_t const granules = granules_of(size);
+		std::uint32_t & head =
+			granules <= bucket_count ? buckets[granules - 1] : large;
+		new (address(offset)) free_block{ head, granules };
+		head = offset;
+	}
+
+	PFL_NODISCARD auto address(std::uint32_t offset) const noexcept -> void *
+	{
+		return base + size_t{ offset } * granularity;
+	}
+
+	PFL_NODISCARD auto offset(void const * p) const noexcept -> std::uint32_t
+	{
+		return static_cast<std::uint32_t>(
+			(static_cast<char const *>(p) - base) / granularity);
+	}
+
+private:
+	static constexpr std::uint32_t bucket_count = 32;
+
+	struct free_block
+	{
+		std::uint32_t next;
+		std::uint32_t granules;
+	};
+
+	static auto checked_capacity(size_t capacity) -> std::uint32_t
+	{
+		if (capacity / granularity > std::numeric_limits<std::uint32_t>::max())
+		{
+			throw std::length_error{ "polymorphic_node_arena too large" };
+		}
+		return static_cast<std::uint32_t>(capacity / granularity);
+	}
+
+	static auto granules_of(size_t size) noexcept -> std::uint32_t
+	{
+		return static_cast<std::uint32_t>(
+			(size + granularity - 1) / granularity);
+	}
+
+	auto block(std::uint32_t offset) const noexcept -> free_block *
+	{
+		return static_cast<free_block *>(address(offset));
+	}
+
+	std::uint32_t const capacity_granules;
+	char * const base;
+	// Offset zero is reserved to mean null.
+	std::uint32_t top = 1;
+	std::uint32_t buckets[bucket_count] = {};
+	std::uint32_t large = 0;
+};
+
+// A polymorphic_forward_list whose nodes live in a `polymorphic_node_arena`.
+// Each node stores its successor as a 32-bit offset into the arena and its
+// element type as a 16-bit index into a table of types, instead of a full
+// pointer, a vtable pointer and a reference, so that the links of a list of
+// small elements take a third of the usual space. Elements may be spliced
+// or merged only between lists sharing an arena, and element types may not be
+// aligned more strictly than `polymorphic_node_arena::granularity`.
+template<class Elem_Base>
+class arena_polymorphic_forward_list
+{
+public:
+	using value_type = Elem_Base;
+	using size_type = size_t;
+	using difference_type = void;
+	using reference = value_type &;
+	using const_reference = value_type const &;
+	using pointer = value_type *;
+	using const_pointer = value_type const *;
+
+	// The number of distinct element types which may be stored in arena lists
+	// of this type over the life of the program. Registering one more throws
+	// `std::length_error`. Bounds the static table of types, which takes
+	// 24 bytes per type on 64-bit targets.
+	static constexpr size_type max_types = 256;
+
+private:
+
+	//--------------------------------------------------------------------------
+	//
+	//
+	// Node Types
+	//
+	//
+	//--------------------------------------------------------------------------
+
+	struct link
+	{
+		link() = delete;
+		link(link const &) = delete;
+		link(link &&) = delete;
+		auto operator=(link const &)->link & = delete;
+		auto operator=(link &&)->link & = delete;
+		~link() = default;
+
+		link(std::uint32_t next) noexcept :
+			next{ next }
+		{ }
+
+		std::uint32_t next;
+	};
+
+	struct basic_node : link
+	{
+		basic_node(std::uint32_t next) noexcept :
+			link{ next },
+			type{ 0 }
+		{ }
+
+		std::uint16_t type;
+	};
+
+	template<class Elem_Derived>
+	struct node : basic_node
+	{
+		static_assert(
+			alignof(Elem_Derived) <= polymorphic_node_arena::granularity,
+			"element type is over-aligned for polymorphic_node_arena");
+
+		template<class ... Args>
+		node(std::uint32_t next, Args && ... args)
+			noexcept(noexcept(Elem_Derived{ std::forward<Args>(args) ... })) :
+			basic_node{ next },
+			elem{ std::forward<Args>(args) ... }
+		{ }
+
+		Elem_Derived elem;
+	};
+
+	struct type_descriptor
+	{
+		std::ptrdiff_t elem_offset;
+		void (*destroy)(basic_node *) noexcept;
+		size_type size;
+	};
+
+	static auto types() noexcept -> type_descriptor *
+	{
+		static type_descriptor table[max_types];
+		return table;
+	}
+
+	template<class Elem_Derived>
+	static void destroy_node(basic_node * n) noexcept
+	{
+		static_cast<node<Elem_Derived> *>(n)->~node();
+	}
+
+	// The offset of the `Elem_Base` subobject is found from the first node of
+	// each type, since it cannot be computed without an object.
+	static auto type_count() noexcept -> std::atomic<size_type> &
+	{
+		static std::atomic<size_type> count{ 0 };
+		return count;
+	}
+
+	template<class Elem_Derived>
+	static auto register_type(node<Elem_Derived> * n) -> std::uint16_t
+	{
+		size_type const index =
+			type_count().fetch_add(1, std::memory_order_relaxed);
+		if (index >= max_types)
+		{
+			throw std::length_error{ "too many arena_polymorphic_forward_list "
+				"element types" };
+		}
+		types()[index] = {
+			reinterpret_cast<char *>(static_cast<pointer>(&n->elem)) -
+				reinterpret_cast<char *>(static_cast<basic_node *>(n)),
+			&destroy_node<Elem_Derived>,
+			sizeof(node<Elem_Derived>) };
+		return static_cast<std::uint16_t>(index);
+	}
+
+	template<class Elem_Derived>
+	static auto type_index(node<Elem_Derived> * n) -> std::uint16_t
+	{
+		static std::uint16_t const index = register_type(n);
+		return index;
+	}
+
+	static auto element(link * n) noexcept -> pointer
+	{
+		return reinterpret_cast<pointer>(
+			reinterpret_cast<char *>(n) +
+			types()[static_cast<basic_node *>(n)->type].elem_offset);
+	}
+
+public:
+
+	//--------------------------------------------------------------------------
+	//
+	//
+	// Iterator Types
+	//
+	//
+	//--------------------------------------------------------------------------
+
+	class iterator;
+	class const_iterator;
+
+	class iterator
+	{
+		friend class arena_polymorphic_forward_list;
+
+	public:
+		using value_type = value_type;
+		using difference_type = difference_type;
+		using pointer = pointer;
+		using reference = reference;
+		using iterator_category = std::forward_iterator_tag;
+
+		iterator() noexcept = default;
+		iterator(iterator const &) noexcept = default;
+		auto operator=(iterator const &) noexcept->iterator & = default;
+
+		auto operator*() const noexcept -> reference
+		{
+			return *element(p);
+		}
+		auto operator->() const noexcept -> pointer
+		{
+			return element(p);
+		}
+
+		auto operator++() noexcept -> iterator &
+		{
+			p = list->next(p);
+			return *this;
+		}
+		auto operator++(int) noexcept -> iterator
+		{
+			iterator copy = *this;
+			p = list->next(p);
+			return copy;
+		}
+
+		auto operator!=(iterator const & other) noexcept -> bool
+		{
+			return p != other.p;
+		}
+		auto operator==(iterator const & other) noexcept -> bool
+		{
+			return p == other.p;
+		}
+
+	private:
+		arena_polymorphic_forward_list const * list = nullptr;
+		link * p = nullptr;
+
+		iterator(const_iterator const & other) :
+			list{ other.list },
+			p{ other.p }
+		{ }
+		iterator(arena_polymorphic_forward_list const * list, link * p)
+			noexcept :
+			list{ list },
+			p{ p }
+		{ }
+	};
+
+	class const_iterator
+	{
+		friend class arena_polymorphic_forward_list;
+
+	public:
+		using difference_type = void;
+		using value_type = value_type;
+		using pointer = const_pointer;
+		using reference = const_reference;
+		using iterator_category = std::forward_iterator_tag;
+
+		const_iterator(iterator const & other) :
+			list{ other.list },
+			p{ other.p }
+		{ }
+
+		const_iterator() noexcept = default;
+		const_iterator(const_iterator const &) noexcept = default;
+		auto operator=(const_iterator const &) noexcept
+			->const_iterator & = default;
+
+		auto operator*() const noexcept -> reference
+		{
+			return *element(p);
+		}
+		auto operator->() const noexcept -> pointer
+		{
+			return element(p);
+		}
+
+		auto operator++() noexcept -> const_iterator &
+		{
+			p = list->next(p);
+			return *this;
+		}
+		auto operator++(int) noexcept -> const_iterator
+		{
+			const_iterator copy = *this;
+			p = list->next(p);
+			return copy;
+		}
+
+		auto operator!=(const_iterator const & other) noexcept -> bool
+		{
+			return p != other.p;
+		}
+		auto operator==(const_iterator const & other) noexcept -> bool
+		{
+			return p == other.p;
+		}
+
+	private:
+		arena_polymorphic_forward_list const * list = nullptr;
+		link * p = nullptr;
+
+		const_iterator(arena_polymorphic_forward_list const * list, link * p)
+			noexcept :
+			list{ list },
+			p{ p }
+		{ }
+	};
+
+	//--------------------------------------------------------------------------
+	//
+	//
+	// Member Functions
+	//
+	//
+	//--------------------------------------------------------------------------
+
+#define PFL_POP(a)														\
+	std::uint32_t const trash = a;										\
+	a = at(trash)->next;												\
+	destroy(trash);
+
+#define PFL_SWAP(a, b)													\
+	std::uint32_t const saved = a;										\
+	a = b;																\
+	b = saved;
+
+	//--------------------------------------------------------------------------
+	//
+	// Constructors / Assignment Operators
+	//
+	//--------------------------------------------------------------------------
+
+	arena_polymorphic_forward_list(arena_polymorphic_forward_list const &)
+		= delete;
+	auto operator=(arena_polymorphic_forward_list const &)
+		->arena_polymorphic_forward_list & = delete;
+
+	explicit arena_polymorphic_forward_list(polymorphic_node_arena & arena)
+		noexcept :
+		arena{ &arena },
+		root{ 0 }
+	{ }
+
+	arena_polymorphic_forward_list(arena_polymorphic_forward_list && other)
+		noexcept :
+		arena{ other.arena },
+		root{ other.root.next }
+	{
+		other.root.next = 0;
+	}
+
+	// Takes the arena of `other` along with its nodes.
+	auto operator=(arena_polymorphic_forward_list && other) noexcept
+		-> arena_polymorphic_forward_list &
+	{
+		std::uint32_t const other_old = other.root.next;
+		other.root.next = 0;
+		clear();
+		arena = other.arena;
+		root.next = other_old;
+		return *this;
+	}
+
+	~arena_polymorphic_forward_list() noexcept
+	{
+		clear();
+	}
+
+	PFL_NODISCARD auto get_arena() const noexcept -> polymorphic_node_arena &
+	{
+		return *arena;
+	}
+
+	//--------------------------------------------------------------------------
+	//
+	// Element Access
+	//
+	//--------------------------------------------------------------------------
+
+	PFL_NODISCARD auto front() noexcept -> reference
+	{
+		return *element(at(root.next));
+	}
+	PFL_NODISCARD auto front() const noexcept -> const_reference
+	{
+		return *element(at(root.next));
+	}
+
+	//--------------------------------------------------------------------------
+	//
+	// Iterators
+	//
+	//--------------------------------------------------------------------------
+
+	PFL_NODISCARD auto before_begin() noexcept -> iterator
+	{
+		return { this, &root };
+	}
+	PFL_NODISCARD auto begin() noexcept -> iterator
+	{
+		return { this, at(root.next) };
+	}
+	PFL_NODISCARD auto end() noexcept -> iterator
+	{
+		return { this, nullptr };
+	}
+
+	PFL_NODISCARD auto before_begin() const noexcept -> const_iterator
+	{
+		return { this, const_cast<link *>(&root) };
+	}
+	PFL_NODISCARD auto begin() const noexcept -> const_iterator
+	{
+		return { this, at(root.next) };
+	}
+	PFL_NODISCARD auto end() const noexcept -> const_iterator
+	{
+		return { this, nullptr };
+	}
+
+	PFL_NODISCARD auto cbefore_begin() const noexcept -> const_iterator
+	{
+		return { this, const_cast<link *>(&root) };
+	}
+	PFL_NODISCARD auto cbegin() const noexcept -> const_iterator
+	{
+		return { this, at(root.next) };
+	}
+	PFL_NODISCARD auto cend() const noexcept -> const_iterator
+	{
+		return { this, nullptr };
+	}
+
+	//--------------------------------------------------------------------------
+	//
+	// Capacity
+	//
+	//--------------------------------------------------------------------------
+
+	PFL_NODISCARD auto empty() const noexcept -> bool
+	{
+		return !root.next;
+	}
+
+	PFL_NODISCARD auto max_size() const noexcept -> size_type
+	{
+		return std::numeric_limits<std::uint32_t>::max();
+	}
+
+	//--------------------------------------------------------------------------
+	//
+	// Modifiers
+	//
+	//--------------------------------------------------------------------------
+
+	void clear() noexcept
+	{
+		while (root.next)
+		{
+			PFL_POP(root.next);
+		}
+	}
+
+	template<class Elem_Derived>
+	auto insert_after(const_iterator pos, Elem_Derived const & value)
+		-> iterator
+	{
+		return emplace_after<Elem_Derived>(pos, value);
+	}
+
+	template<class Elem_Derived>
+	auto insert_after(const_iterator pos, Elem_Derived && value) -> iterator
+	{
+		return emplace_after<std::decay_t<Elem_Derived>>(
+			pos,
+			std::forward<Elem_Derived>(value));
+	}
+
+	template<class Elem_Derived = Elem_Base, class ... Args>
+	auto emplace_after(const_iterator pos, Args && ... args) -> iterator
+	{
+		pos.p->next = make_node<Elem_Derived>(
+			pos.p->next,
+			std::forward<Args>(args) ...);
+		return { this, at(pos.p->next) };
+	}
+
+	auto erase_after(const_iterator pos) noexcept -> iterator
+	{
+		PFL_POP(pos.p->next);
+		return { this, at(pos.p->next) };
+	}
+
+	auto erase_after(const_iterator first, const_iterator last) noexcept
+		-> iterator
+	{
+		std::uint32_t const last_offset = offset(last.p);
+		while (first.p->next != last_offset)
+		{
+			PFL_POP(first.p->next);
+		}
+		return { this, last.p };
+	}
+
+	template<class Elem_Derived>
+	void push_front(Elem_Derived const & value)
+	{
+		emplace_front<Elem_Derived>(value);
+	}
+
+	template<class Elem_Derived>
+	void push_front(Elem_Derived && value)
+	{
+		emplace_front<std::decay_t<Elem_Derived>>(
+			std::forward<Elem_Derived>(value));
+	}
+
+	template<class Elem_Derived = Elem_Base, class ... Args>
+	auto emplace_front(Args && ... args) -> reference
+	{
+		root.next = make_node<Elem_Derived>(
+			root.next,
+			std::forward<Args>(args) ...);
+		return front();
+	}
+
+	void pop_front() noexcept
+	{
+		PFL_POP(root.next);
+	}
+
+	// Exchanges arenas along with nodes.
+	void swap(arena_polymorphic_forward_list & other) noexcept
+	{
+		PFL_SWAP(root.next, other.root.next);
+		std::swap(arena, other.arena);
+	}
+
+	//--------------------------------------------------------------------------
+	//
+	// Operations
+	//
+	//--------------------------------------------------------------------------
+
+	// Every operation taking another list requires that it share this list's
+	// arena.
+
+#define PFL_SPLICE_ONE(a, b)											\
+	std::uint32_t const saved = a;										\
+	a = b;																\
+	b = at(a)->next;													\
+	at(a)->next = saved;
+
+	//--------------------------------------------------------------------------
+	// Merges
+	//--------------------------------------------------------------------------
+
+#define PFL_MERGE(op)													\
+	assert(arena == other.arena);										\
+	if (this == &other) return;											\
+	if (!other.root.next) return;										\
+	auto const less = [&](std::uint32_t a, std::uint32_t b)				\
+	{																	\
+		return op;														\
+	};																	\
+	link * pivot = &root;												\
+	while (pivot->next && other.root.next)								\
+	{																	\
+		if (less(other.root.next, pivot->next))							\
+		{																\
+			link * run_last = at(other.root.next);						\
+			while (run_last->next && less(run_last->next, pivot->next))	\
+			{															\
+				run_last = at(run_last->next);							\
+			}															\
+			std::uint32_t const saved = pivot->next;					\
+			pivot->next = other.root.next;								\
+			other.root.next = run_last->next;							\
+			run_last->next = saved;										\
+			pivot = at(saved);											\
+		}																\
+		else															\
+		{																\
+			pivot = at(pivot->next);									\
+		}																\
+	}																	\
+	if (other.root.next)												\
+	{																	\
+		PFL_SWAP(other.root.next, pivot->next);							\
+	}
+
+	void merge(arena_polymorphic_forward_list & other)
+	{
+		PFL_MERGE(*element(at(a)) < *element(at(b)));
+	}
+
+	void merge(arena_polymorphic_forward_list && other)
+	{
+		PFL_MERGE(*element(at(a)) < *element(at(b)));
+	}
+
+	template<class Compare>
+	void merge(arena_polymorphic_forward_list & other, Compare comp)
+	{
+		PFL_MERGE(comp(*element(at(a)), *element(at(b))));
+	}
+
+	template<class Compare>
+	void merge(arena_polymorphic_forward_list && other, Compare comp)
+	{
+		PFL_MERGE(comp(*element(at(a)), *element(at(b))));
+	}
+
+#undef PFL_MERGE
+
+	//--------------------------------------------------------------------------
+	// Splices
+	//--------------------------------------------------------------------------
+
+#define PFL_SPLICE(a, b, c, condition)									\
+	std::uint32_t const saved = a->next;								\
+	a->next = b;														\
+	b = c;																\
+	while (condition) a = at(a->next);									\
+	a->next = saved;
+
+	void splice_after(
+		const_iterator pos,
+		arena_polymorphic_forward_list & other) noexcept
+	{
+		assert(arena == other.arena);
+		PFL_SPLICE(pos.p, other.root.next, 0, pos.p->next);
+	}
+
+	void splice_after(
+		const_iterator pos,
+		arena_polymorphic_forward_list && other) noexcept
+	{
+		assert(arena == other.arena);
+		PFL_SPLICE(pos.p, other.root.next, 0, pos.p->next);
+	}
+
+	void splice_after(const_iterator pos, const_iterator it) noexcept
+	{
+		assert(arena == it.list->arena);
+		PFL_SPLICE_ONE(pos.p->next, it.p->next);
+	}
+
+	void splice_after(
+		const_iterator pos,
+		const_iterator first,
+		const_iterator last)
+		noexcept
+	{
+		assert(arena == first.list->arena);
+		std::uint32_t const last_offset = offset(last.p);
+		PFL_SPLICE(
+			pos.p,
+			first.p->next,
+			last_offset,
+			pos.p->next != last_offset);
+	}
+
+#undef PFL_SPLICE
+
+	//--------------------------------------------------------------------------
+	// Removals
+	//--------------------------------------------------------------------------
+
+#define PFL_REMOVE(op)													\
+	size_type removed_count = 0;										\
+	for (link * pivot = &root; pivot->next;)							\
+	{																	\
+		if (op)															\
+		{																\
+			PFL_POP(pivot->next);										\
+			removed_count++;											\
+		}																\
+		else															\
+		{																\
+			pivot = at(pivot->next);									\
+		}																\
+	}																	\
+	return removed_count;
+
+	auto remove(const_reference value) -> size_type
+	{
+		PFL_REMOVE(*element(at(pivot->next)) == value);
+	}
+
+	template<class UnaryPredicate>
+	auto remove_if(UnaryPredicate p) -> size_type
+	{
+		PFL_REMOVE(p(*element(at(pivot->next))));
+	}
+
+	void reverse() noexcept
+	{
+		link reverse_root = 0;
+		while (root.next)
+		{
+			PFL_SPLICE_ONE(reverse_root.next, root.next);
+		}
+		root.next = reverse_root.next;
+	}
+
+#undef PFL_REMOVE
+
+#undef PFL_SPLICE_ONE
+
+#undef PFL_POP
+#undef PFL_SWAP
+
+private:
+	polymorphic_node_arena * arena;
+	link root;
+
+	auto at(std::uint32_t offset) const noexcept -> link *
+	{
+		return offset ? static_cast<link *>(arena->address(offset)) : nullptr;
+	}
+
+	auto next(link const * l) const noexcept -> link *
+	{
+		return at(l->next);
+	}
+
+	// The offset of a node, or zero for the end of the list.
+	auto offset(link const * p) const noexcept -> std::uint32_t
+	{
+		return p ? arena->offset(p) : 0;
+	}
+
+	template<class Elem_Derived, class ... Args>
+	auto make_node(std::uint32_t next, Args && ... args) -> std::uint32_t
+	{
+		std::uint32_t const offset =
+			arena->allocate(sizeof(node<Elem_Derived>));
+		node<Elem_Derived> * n;
+		try
+		{
+			n = new (arena->address(offset))
+				node<Elem_Derived>(next, std::forward<Args>(args) ...);
+		}
+		catch (...)
+		{
+			arena->deallocate(offset, sizeof(node<Elem_Derived>));
+			throw;
+		}
+		try
+		{
+			n->type = type_index(n);
+		}
+		catch (...)
+		{
+			n->~node();
+			arena->deallocate(offset, sizeof(node<Elem_Derived>));
+			throw;
+		}
+		return offset;
+	}
+
+	void destroy(std::uint32_t offset) noexcept
+	{
+		basic_node * const n = static_cast<basic_node *>(at(offset));
+		type_descriptor const & type = types()[n->type];
+		type.destroy(n);
+		arena->deallocate(offset, type.size);
+	}
+};
+
+//------------------------------------------------------------------------------
+//
+//
+// Concurrent List
+//
+//
+//------------------------------------------------------------------------------
+
+// A polymorphic_forward_list which one writer thread may modify while any
+// number of reader threads traverse it. The writer publishes every link with
+// a release store. A reader traverses through a `read_guard`, which announces
+// the epoch in which it started; traversal takes only acquire loads and never
+// waits. Nodes unlinked by the writer are retired and destroyed by the writer
+// only once every reader which might still reach them has finished.
+//
+// A reader traversing while `splice_after` moves a range may skip or repeat
+// any of the nodes between the source and the destination of the move,
+// including the moved nodes themselves, but never finds a cycle. Elements
+// reachable by readers must not be modified unless the element type
+// synchronizes its own state.
+template<class Elem_Base, class Node_Allocator = default_node_allocator>
+class concurrent_polymorphic_forward_list
+{
+public:
+	using value_type = Elem_Base;
+	using size_type = size_t;
+	using difference_type = void;
+	using reference = value_type &;
+	using const_reference = value_type const &;
+	using pointer = value_type *;
+	using const_pointer = value_type const *;
+
+	// The least number of retired nodes at which a writer operation reclaims.
+	// After each reclamation, the next happens once the nodes still retired
+	// have doubled, so that reclamation stays amortized O(1) per node while
+	// a reader holds a guard.
+	static constexpr size_type reclaim_threshold = 64;
+
+private:
+
+	//--------------------------------------------------------------------------
+	//
+	//
+	// Node Types
+	//
+	//
+	//--------------------------------------------------------------------------
+
+	struct basic_node;
+
+	struct link
+	{
+		link() = delete;
+		link(link const &) = delete;
+		link(link &&) = delete;
+		auto operator=(link const &)->link & = delete;
+		auto operator=(link &&)->link & = delete;
+		~link() = default;
+
+		link(basic_node * next) noexcept :
+			next{ next }
+		{ }
+
+		std::atomic<basic_node *> next;
+	};
+
+	struct basic_node : link, polymorphic_node_allocation<Node_Allocator>
+	{
+		basic_node(basic_node * next, reference ref) noexcept :
+			link{ next },
+			ref{ ref }
+		{ }
+
+		virtual ~basic_node() noexcept = default;
+
+		reference ref;
+	};
+
+	template<class Elem_Derived>
+	struct basic_owner
+	{
+		template<class ... Args>
+		basic_owner(Args && ... args)
+			noexcept(noexcept(Elem_Derived{ std::forward<Args>(args) ... })) :
+			elem{ std::forward<Args>(args) ... }
+		{ }
+
+		Elem_Derived elem;
+	};
+
+	template<class Elem_Derived>
+	struct node : basic_owner<Elem_Derived>, basic_node
+	{
+		template<class ... Args>
+		node(basic_node * next, Args && ... args)
+			noexcept(noexcept(Elem_Derived{ std::forward<Args>(args) ... })) :
+			basic_owner<Elem_Derived>{ std::forward<Args>(args) ... },
+			basic_node{ next, basic_owner<Elem_Derived>::elem }
+		{ }
+	};
+
+	//--------------------------------------------------------------------------
+	//
+	//
+	// Epochs
+	//
+	//
+	//--------------------------------------------------------------------------
+
+	static constexpr std::uint64_t quiescent =
+		std::numeric_limits<std::uint64_t>::max();
+
+	// Records are claimed by readers for the duration of a guard and are
+	// never freed before the list.
+	struct alignas(64) reader_record
+	{
+		std::atomic<std::uint64_t> epoch{ quiescent };
+		std::atomic<bool> claimed{ true };
+		reader_record * next = nullptr;
+	};
+
+	// An epoch of zero marks a node unlinked by an operation which has not
+	// yet sealed its retired nodes.
+	struct retired_node
+	{
+		basic_node * node;
+		std::uint64_t epoch;
+	};
+
+	auto enter() const -> reader_record *
+	{
+		reader_record * record = readers.load(std::memory_order_acquire);
+		for (; record; record = record->next)
+		{
+			bool expected = false;
+			if (!record->claimed.load(std::memory_order_relaxed) &&
+				record->claimed.compare_exchange_strong(
+					expected,
+					true,
+					std::memory_order_acquire))
+			{
+				break;
+			}
+		}
+		if (!record)
+		{
+			record = new reader_record;
+			record->next = readers.load(std::memory_order_relaxed);
+			while (!readers.compare_exchange_weak(
+				record->next,
+				record,
+				std::memory_order_release,
+				std::memory_order_relaxed));
+		}
+		// An epoch which is stale by the time it is announced only delays
+		// reclamation. The fence pairs with the one in `reclaim`.
+		record->epoch.store(
+			epoch.load(std::memory_order_acquire),
+			std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		return record;
+	}
+
+	static void exit(reader_record * record) noexcept
+	{
+		record->epoch.store(quiescent, std::memory_order_release);
+		record->claimed.store(false, std::memory_order_release);
+	}
+
+public:
+
+	//--------------------------------------------------------------------------
+	//
+	//
+	// Iterator Types
+	//
+	//
+	//--------------------------------------------------------------------------
+
+	class iterator;
+	class const_iterator;
+
+	class iterator
+	{
+		friend class concurrent_polymorphic_forward_list;
+
+	public:
+		using value_type = value_type;
+		using difference_type = difference_type;
+		using pointer = pointer;
+		using reference = reference;
+		using iterator_category = std::forward_iterator_tag;
+
+		iterator() noexcept = default;
+		iterator(iterator const &) noexcept = default;
+		auto operator=(iterator const &) noexcept->iterator & = default;
+
+		auto operator*() const noexcept -> reference
+		{
+			return static_cast<basic_node &>(*p).ref;
+		}
+		auto operator->() const noexcept -> pointer
+		{
+			return &static_cast<basic_node &>(*p).ref;
+		}
+
+		auto operator++() noexcept -> iterator &
+		{
+			p = p->next.load(std::memory_order_acquire);
+			return *this;
+		}
+		auto operator++(int) noexcept -> iterator
+		{
+			iterator copy = *this;
+			p = p->next.load(std::memory_order_acquire);
+			return copy;
+		}
+
+		auto operator!=(iterator const & other) noexcept -> bool
+		{
+			return p != other.p;
+		}
+		auto operator==(iterator const & other) noexcept -> bool
+		{
+			return p == other.p;
+		}
+
+	private:
+		link * p = nullptr;
+
+		iterator(const_iterator const & other) :
+			p{ other.p }
+		{ }
+		iterator(link * p) noexcept :
+			p{ p }
+		{ }
+	};
+
+	class const_iterator
+	{
+		friend class concurrent_polymorphic_forward_list;
+
+	public:
+		using difference_type = void;
+		using value_type = value_type;
+		using pointer = const_pointer;
+		using reference = const_reference;
+		using iterator_category = std::forward_iterator_tag;
+
+		const_iterator(iterator const & other) :
+			p{ other.p }
+		{ }
+
+		const_iterator() noexcept = default;
+		const_iterator(const_iterator const &) noexcept = default;
+		auto operator=(const_iterator const &) noexcept
+			->const_iterator & = default;
+
+		auto operator*() const noexcept -> reference
+		{
+			return static_cast<basic_node const &>(*p).ref;
+		}
+		auto operator->() const noexcept -> pointer
+		{
+			return &static_cast<basic_node const &>(*p).ref;
+		}
+
+		auto operator++() noexcept -> const_iterator &
+		{
+			p = p->next.load(std::memory_order_acquire);
+			return *this;
+		}
+		auto operator++(int) noexcept -> const_iterator
+		{
+			const_iterator copy = *this;
+			p = p->next.load(std::memory_order_acquire);
+			return copy;
+		}
+
+		auto operator!=(const_iterator const & other) noexcept -> bool
+		{
+			return p != other.p;
+		}
+		auto operator==(const_iterator const & other) noexcept -> bool
+		{
+			return p == other.p;
+		}
+
+	private:
+		link * p = nullptr;
+
+		const_iterator(link * p) noexcept :
+			p{ p }
+		{ }
+	};
+
+	// Pins the nodes reachable from the list for the lifetime of the guard.
+	// A guard is used by one thread at a time.
+	class read_guard
+	{
+	public:
+		explicit read_guard(concurrent_polymorphic_forward_list const & list) :
+			list{ &list },
+			record{ list.enter() }
+		{ }
+
+		read_guard(read_guard const &) = delete;
+		auto operator=(read_guard const &)->read_guard & = delete;
+
+		~read_guard() noexcept
+		{
+			exit(record);
+		}
+
+		PFL_NODISCARD auto begin() const noexcept -> const_iterator
+		{
+			return list->root.next.load(std::memory_order_acquire);
+		}
+		PFL_NODISCARD auto end() const noexcept -> const_iterator
+		{
+			return nullptr;
+		}
+
+		PFL_NODISCARD auto empty() const noexcept -> bool
+		{
+			return !list->root.next.load(std::memory_order_acquire);
+		}
+
+	private:
+		concurrent_polymorphic_forward_list const * list;
+		reader_record * record;
+	};
+
+	//--------------------------------------------------------------------------
+	//
+	//
+	// Member Functions
+	//
+	//
+	//--------------------------------------------------------------------------
+
+	// Unless stated otherwise, member functions are to be called only by the
+	// writer.
+
+	//--------------------------------------------------------------------------
+	//
+	// Constructors / Assignment Operators
+	//
+	//--------------------------------------------------------------------------
+
+	concurrent_polymorphic_forward_list(
+		concurrent_polymorphic_forward_list const &) = delete;
+	auto operator=(concurrent_polymorphic_forward_list const &)
+		->concurrent_polymorphic_forward_list & = delete;
+
+	concurrent_polymorphic_forward_list() noexcept :
+		root{ nullptr }
+	{ }
+
+	// There must be no readers.
+	~concurrent_polymorphic_forward_list() noexcept
+	{
+		basic_node * n = root.next.load(std::memory_order_relaxed);
+		while (n)
+		{
+			basic_node * const trash = n;
+			n = trash->next.load(std::memory_order_relaxed);
+			delete trash;
+		}
+		for (retired_node const & r : retired)
+		{
+			delete r.node;
+		}
+		reader_record * record = readers.load(std::memory_order_acquire);
+		while (record)
+		{
+			reader_record * const trash = record;
+			record = trash->next;
+			delete trash;
+		}
+	}
+
+	// May be called by any thread.
+	PFL_NODISCARD auto read() const -> read_guard
+	{
+		return read_guard{ *this };
+	}
+
+	//--------------------------------------------------------------------------
+	//
+	// Element Access / Iterators / Capacity
+	//
+	//--------------------------------------------------------------------------
+
+	PFL_NODISCARD auto front() noexcept -> reference
+	{
+		return root.next.load(std::memory_order_relaxed)->ref;
+	}
+
+	PFL_NODISCARD auto before_begin() noexcept -> iterator
+	{
+		return &root;
+	}
+	PFL_NODISCARD auto begin() noexcept -> iterator
+	{
+		return root.next.load(std::memory_order_relaxed);
+	}
+	PFL_NODISCARD auto end() noexcept -> iterator
+	{
+		return nullptr;
+	}
+
+	PFL_NODISCARD auto empty() const noexcept -> bool
+	{
+		return !root.next.load(std::memory_order_relaxed);
+	}
+
+	//--------------------------------------------------------------------------
+	//
+	// Modifiers
+	//
+	//--------------------------------------------------------------------------
+
+	void clear()
+	{
+		retire_after(&root, nullptr);
+	}
+
+	template<class Elem_Derived>
+	auto insert_after(const_iterator pos, Elem_Derived const & value)
+		-> iterator
+	{
+		return emplace_after<Elem_Derived>(pos, value);
+	}
+
+	template<class Elem_Derived>
+	auto insert_after(const_iterator pos, Elem_Derived && value) -> iterator
+	{
+		return emplace_after<std::decay_t<Elem_Derived>>(
+			pos,
+			std::forward<Elem_Derived>(value));
+	}
+
+	template<class Elem_Derived = Elem_Base, class ... Args>
+	auto emplace_after(const_iterator pos, Args && ... args) -> iterator
+	{
+		basic_node * const new_node = new node<Elem_Derived>(
+			pos.p->next.load(std::memory_order_relaxed),
+			std::forward<Args>(args) ...);
+		pos.p->next.store(new_node, std::memory_order_release);
+		return new_node;
+	}
+
+	auto erase_after(const_iterator pos) -> iterator
+	{
+		basic_node * const trash = pos.p->next.load(std::memory_order_relaxed);
+		return retire_after(
+			pos.p,
+			trash->next.load(std::memory_order_relaxed));
+	}
+
+	auto erase_after(const_iterator first, const_iterator last) -> iterator
+	{
+		return retire_after(first.p, static_cast<basic_node *>(last.p));
+	}
+
+	template<class Elem_Derived>
+	void push_front(Elem_Derived const & value)
+	{
+		emplace_after<Elem_Derived>(before_begin(), value);
+	}
+
+	template<class Elem_Derived>
+	void push_front(Elem_Derived && value)
+	{
+		emplace_after<std::decay_t<Elem_Derived>>(
+			before_begin(),
+			std::forward<Elem_Derived>(value));
+	}
+
+	template<class Elem_Derived = Elem_Base, class ... Args>
+	auto emplace_front(Args && ... args) -> reference
+	{
+		return *emplace_after<Elem_Derived>(
+			before_begin(),
+			std::forward<Args>(args) ...);
+	}
+
+	void pop_front()
+	{
+		erase_after(before_begin());
+	}
+
+	//--------------------------------------------------------------------------
+	//
+	// Operations
+	//
+	//--------------------------------------------------------------------------
+
+	// Moves the element after `it` to after `pos`.
+	void splice_after(const_iterator pos, const_iterator it) noexcept
+	{
+		basic_node * const moved = it.p->next.load(std::memory_order_relaxed);
+		if (pos.p == it.p || pos.p == moved) return;
+		splice_after(pos, it, moved->next.load(std::memory_order_relaxed));
+	}
+
+	// Moves the elements in (first, last) to after `pos`, which must not be
+	// in that range. The range is unlinked before it is relinked, so that a
+	// reader never finds a cycle, though it may skip or repeat the nodes
+	// between `first` and `pos`.
+	void splice_after(
+		const_iterator pos,
+		const_iterator first,
+		const_iterator last)
+		noexcept
+	{
+		basic_node * const head = first.p->next.load(std::memory_order_relaxed);
+		if (head == last.p) return;
+		link * tail = head;
+		basic_node * tail_next;
+		while ((tail_next = tail->next.load(std::memory_order_relaxed)) !=
+			last.p)
+		{
+			tail = tail_next;
+		}
+		first.p->next.store(tail_next, std::memory_order_release);
+		tail->next.store(
+			pos.p->next.load(std::memory_order_relaxed),
+			std::memory_order_release);
+		pos.p->next.store(head, std::memory_order_release);
+	}
+
+	// Every node removed by a call is retired in a single epoch.
+	template<class UnaryPredicate>
+	auto remove_if(UnaryPredicate p) -> size_type
+	{
+		size_type const first_retired = retired.size();
+		link * pivot = &root;
+		basic_node * n;
+		try
+		{
+			while ((n = pivot->next.load(std::memory_order_relaxed)))
+			{
+				if (p(n->ref))
+				{
+					reserve_retired(1);
+					pivot->next.store(
+						n->next.load(std::memory_order_relaxed),
+						std::memory_order_release);
+					retired.push_back({ n, 0 });
+				}
+				else
+				{
+					pivot = n;
+				}
+			}
+		}
+		catch (...)
+		{
+			seal_retired(first_retired);
+			throw;
+		}
+		size_type const removed_count = retired.size() - first_retired;
+		seal_retired(first_retired);
+		return removed_count;
+	}
+
+	auto remove(const_reference value) -> size_type
+	{
+		return remove_if([&](const_reference elem) { return elem == value; });
+	}
+
+	// Destroys every retired node which no reader can still reach.
+	void reclaim() noexcept
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		std::uint64_t oldest = quiescent;
+		for (reader_record * record = readers.load(std::memory_order_acquire);
+			record;
+			record = record->next)
+		{
+			std::uint64_t const e =
+				record->epoch.load(std::memory_order_acquire);
+			if (e < oldest) oldest = e;
+		}
+		size_type kept = 0;
+		for (retired_node const & r : retired)
+		{
+			if (r.epoch <= oldest)
+			{
+				delete r.node;
+			}
+			else
+			{
+				retired[kept++] = r;
+			}
+		}
+		retired.resize(kept);
+		reclaim_at = 2 * kept > reclaim_threshold ?
+			2 * kept :
+			reclaim_threshold;
+	}
+
+private:
+	link root;
+	std::atomic<std::uint64_t> mutable epoch{ 1 };
+	std::atomic<reader_record *> mutable readers{ nullptr };
+	std::vector<retired_node> retired;
+	size_type reclaim_at = reclaim_threshold;
+
+	// Grows the retired list geometrically, so that `count` more nodes may be
+	// retired without throwing.
+	void reserve_retired(size_type count)
+	{
+		size_type const needed = retired.size() + count;
+		if (needed <= retired.capacity()) return;
+		size_type const doubled = 2 * retired.capacity();
+		retired.reserve(needed > doubled ? needed : doubled);
+	}
+
+	// Stamps the nodes retired since `first_retired` with a new epoch, after
+	// they have all been unlinked, and reclaims if enough nodes are retired.
+	// Readers which announce this epoch or later cannot reach those nodes.
+	void seal_retired(size_type first_retired) noexcept
+	{
+		if (first_retired == retired.size()) return;
+		std::uint64_t const retire_epoch =
+			epoch.fetch_add(1, std::memory_order_acq_rel) + 1;
+		for (size_type i = first_retired; i < retired.size(); i++)
+		{
+			retired[i].epoch = retire_epoch;
+		}
+		if (retired.size() >= reclaim_at) reclaim();
+	}
+
+	// Unlinks (pos, last) and retires its nodes. Throws only if the retired
+	// list cannot grow, in which case nothing is unlinked.
+	auto retire_after(link * pos, basic_node * last) -> iterator
+	{
+		basic_node * const head = pos->next.load(std::memory_order_relaxed);
+		size_type count = 0;
+		for (basic_node * n = head; n != last;
+			n = n->next.load(std::memory_order_relaxed))
+		{
+			count++;
+		}
+		reserve_retired(count);
+		size_type const first_retired = retired.size();
+		pos->next.store(last, std::memory_order_release);
+		for (basic_node * n = head; n != last;
+			n = n->next.load(std::memory_order_relaxed))
+		{
+			retired.push_back({ n, 0 });
+		}
+		seal_retired(first_retired);
+		return last;
+	}
+};
+
 #undef PFL_NODISCARD
+#undef PFL_CONSTEXPR
+#undef PFL_PREFETCH
 
 #endif
@@ -0,0 +1,239 @@
+/* Copyright (C) 2019 Theodoric E. Stier - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * INFO: This file is intended to be viewed using a horizontal tab width of 4.
+ */
+
+// Stress test for the epoch-based reclamation of
+// `concurrent_polymorphic_forward_list`. One writer applies a random mix of
+// every writer operation while readers traverse the list, checking that no
+// element they reach has been destroyed and that no traversal finds a cycle.
+// Meant to be run under ThreadSanitizer and AddressSanitizer as well as
+// without them. Returns nonzero on failure.
+
+/*
+	g++ -std=c++17 -O1 -g -pthread -fpermissive -fsanitize=thread \
+		-I../polymorphic_forward_list \
+		concurrent_polymorphic_forward_list_stress.cpp
+*/
+
+#include "polymorphic_forward_list.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	constexpr std::uint32_t alive = 0x600DF00D;
+	constexpr std::uint32_t dead = 0xDEADBEEF;
+	constexpr std::size_t max_size = 512;
+	constexpr std::size_t writer_operations = 200000;
+
+	std::atomic<long> live{ 0 };
+	std::atomic<bool> failed{ false };
+
+	void fail(char const * message)
+	{
+		if (!failed.exchange(true)) std::fprintf(stderr, "FAIL: %s\n", message);
+	}
+
+	struct Item
+	{
+		explicit Item(int value) :
+			value{ value }
+		{
+			live.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		virtual ~Item()
+		{
+			magic.store(dead, std::memory_order_relaxed);
+			live.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		auto operator==(Item const & other) const -> bool
+		{
+			return value == other.value;
+		}
+
+		std::atomic<std::uint32_t> magic{ alive };
+		int value;
+	};
+
+	struct Big : Item
+	{
+		using Item::Item;
+		long payload[8] = {};
+	};
+
+	using list = concurrent_polymorphic_forward_list<Item>;
+
+	// Returns the iterator before a uniformly chosen position.
+	auto before(list & l, std::size_t size, std::mt19937 & random)
+		-> list::iterator
+	{
+		auto it = l.before_begin();
+		std::size_t const steps = size ? random() % size : 0;
+		for (std::size_t i = 0; i < steps; i++) ++it;
+		return it;
+	}
+
+	void reader(list const & l, std::atomic<bool> const & stop, long & reads)
+	{
+		while (!stop.load(std::memory_order_relaxed))
+		{
+			auto const guard = l.read();
+			std::size_t length = 0;
+			for (Item const & item : guard)
+			{
+				if (item.magic.load(std::memory_order_relaxed) != alive)
+				{
+					fail("reader reached a destroyed element");
+					return;
+				}
+				// Every node ever reachable is bounded by the list size plus
+				// the nodes spliced ahead of a reader during its traversal.
+				if (++length > 4 * max_size * max_size)
+				{
+					fail("reader found a cycle");
+					return;
+				}
+			}
+			reads++;
+		}
+	}
+
+	// The writer mirrors the list size so that it can choose positions.
+	void writer(list & l)
+	{
+		std::mt19937 random{ 20190101 };
+		std::size_t size = 0;
+		for (std::size_t op = 0; op < writer_operations; op++)
+		{
+			int const value = static_cast<int>(op);
+			switch (random() % 10)
+			{
+			case 0:
+			case 1:
+				if (size == max_size) break;
+				l.emplace_front<Big>(value);
+				size++;
+				break;
+			case 2:
+			case 3:
+				if (size == max_size) break;
+				l.emplace_after<Item>(before(l, size, random), value);
+				size++;
+				break;
+			case 4:
+			{
+				if (!size) break;
+				auto it = before(l, size, random);
+				l.erase_after(it);
+				size--;
+				break;
+			}
+			case 5:
+			{
+				if (!size) break;
+				auto first = before(l, size, random);
+				auto last = first;
+				std::size_t count = 0;
+				for (++last; last != l.end() && count < 8; ++last) count++;
+				l.erase_after(first, last);
+				size -= count;
+				break;
+			}
+			case 6:
+			case 7:
+			{
+				if (size < 2) break;
+				auto it = before(l, size - 1, random);
+				auto pos = before(l, size, random);
+				auto moved = it;
+				++moved;
+				if (pos != it && pos != moved) l.splice_after(pos, it);
+				break;
+			}
+			case 8:
+				if (random() % 64) break;
+				size -= l.remove_if([&](Item const & item)
+				{
+					return item.value % 3 == 0;
+				});
+				break;
+			case 9:
+				if (random() % 512) break;
+				l.clear();
+				size = 0;
+				break;
+			}
+		}
+	}
+
+	// A reader holding a guard keeps every node it could reach alive.
+	void test_pinning()
+	{
+		list l;
+		for (int i = 0; i < 1000; i++) l.emplace_front<Item>(i);
+		{
+			auto const guard = l.read();
+			Item const & first = *guard.begin();
+			l.clear();
+			for (int i = 0; i < 1000; i++)
+			{
+				l.emplace_front<Item>(i);
+				l.pop_front();
+			}
+			l.reclaim();
+			if (first.magic.load() != alive)
+			{
+				fail("a guarded element was reclaimed");
+			}
+		}
+		l.reclaim();
+		if (live.load() != 0) fail("unguarded nodes were not reclaimed");
+	}
+
+	void test_concurrent(unsigned readers)
+	{
+		long reads = 0;
+		{
+			list l;
+			std::atomic<bool> stop{ false };
+			std::vector<long> counts(readers);
+			std::vector<std::thread> threads;
+			for (unsigned r = 0; r < readers; r++)
+			{
+				threads.emplace_back(
+					reader, std::cref(l), std::cref(stop), std::ref(counts[r]));
+			}
+			writer(l);
+			stop = true;
+			for (std::thread & thread : threads) thread.join();
+			for (long count : counts) reads += count;
+		}
+		if (live.load() != 0) fail("nodes leaked");
+		std::printf("readers %u: %ld traversals\n", readers, reads);
+	}
+}
+
+int main()
+{
+	test_pinning();
+	for (unsigned readers : { 1u, 2u, 4u, 8u })
+	{
+		if (failed) break;
+		test_concurrent(readers);
+	}
+	if (failed) return EXIT_FAILURE;
+	std::puts("ok");
+	return EXIT_SUCCESS;
+}